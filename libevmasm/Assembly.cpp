@@ -34,6 +34,7 @@
 #include <liblangutil/Exceptions.h>
 
 #include <libsolutil/JSON.h>
+#include <libsolutil/Parallel.h>
 #include <libsolutil/StringUtils.h>
 
 #include <fmt/format.h>
@@ -53,6 +54,7 @@ using namespace solidity::langutil;
 using namespace solidity::util;
 
 std::map<std::string, std::shared_ptr<std::string const>> Assembly::s_sharedSourceNames;
+std::mutex Assembly::s_sharedSourceNamesMutex;
 
 AssemblyItem const& Assembly::append(AssemblyItem _i)
 {
@@ -644,6 +646,7 @@ void Assembly::encodeAllPossibleSubPathsInAssemblyTree(std::vector<size_t> _path
 
 std::shared_ptr<std::string const> Assembly::sharedSourceName(std::string const& _name) const
 {
+	std::lock_guard<std::mutex> lock(s_sharedSourceNamesMutex);
 	if (s_sharedSourceNames.find(_name) == s_sharedSourceNames.end())
 		s_sharedSourceNames[_name] = std::make_shared<std::string>(_name);
 
@@ -685,32 +688,59 @@ AssemblyItem Assembly::newImmutableAssignment(std::string const& _identifier)
 	return AssemblyItem{AssignImmutable, h};
 }
 
-Assembly& Assembly::optimise(OptimiserSettings const& _settings)
+Assembly& Assembly::optimise(OptimiserSettings const& _settings, size_t _concurrency)
 {
-	optimiseInternal(_settings, {});
+	optimiseInternal(_settings, {}, _concurrency);
 	return *this;
 }
 
+namespace
+{
+
+/// @returns false if an assembly can be reached from @a _assembly in more than one way,
+/// i.e. if it is a sub-assembly of several assemblies or appears several times as a sub-assembly.
+bool subAssembliesAreDistinct(Assembly const& _assembly, std::set<Assembly const*>& _seen)
+{
+	for (size_t subId = 0; subId < _assembly.numSubs(); ++subId)
+	{
+		Assembly const& sub = _assembly.sub(subId);
+		if (!_seen.insert(&sub).second || !subAssembliesAreDistinct(sub, _seen))
+			return false;
+	}
+	return true;
+}
+
+}
+
 std::map<u256, u256> const& Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
-	std::set<size_t> _tagsReferencedFromOutside
+	std::set<size_t> _tagsReferencedFromOutside,
+	size_t _concurrency
 )
 {
 	if (m_tagReplacements)
 		return *m_tagReplacements;
 
-	// Run optimisation for sub-assemblies.
+	// Run optimisation for sub-assemblies. The replacements of the tags of one sub-assembly do not
+	// affect the references to the tags of the others, so the sub-assemblies can be optimised
+	// concurrently, unless the same one would then be optimised by two threads.
+	std::vector<std::set<size_t>> referencedSubTags;
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
-	{
-		OptimiserSettings settings = _settings;
-		Assembly& sub = *m_subs[subId];
-		std::map<u256, u256> const& subTagReplacements = sub.optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
+		referencedSubTags.emplace_back(JumpdestRemover::referencedTags(m_items, subId));
+	std::set<Assembly const*> seen;
+	size_t concurrency = (_concurrency > 1 && subAssembliesAreDistinct(*this, seen)) ? _concurrency : 1;
+	size_t subConcurrency = std::max<size_t>(1, concurrency / std::max<size_t>(1, m_subs.size()));
+	std::vector<std::map<u256, u256> const*> subTagReplacements(m_subs.size(), nullptr);
+	parallelFor(m_subs.size(), concurrency, [&](size_t _subId) {
+		subTagReplacements[_subId] = &m_subs[_subId]->optimiseInternal(
+			_settings,
+			std::move(referencedSubTags[_subId]),
+			subConcurrency
 		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
-	}
+	});
+	// Apply the replacements (can be empty).
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		BlockDeduplicator::applyTagReplacement(m_items, *subTagReplacements[subId], subId);
 
 	std::map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
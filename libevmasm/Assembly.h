@@ -38,6 +38,7 @@
 #include <sstream>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <utility>
 
 namespace solidity::evmasm
@@ -134,7 +135,9 @@ public:
 
 	/// Modify and return the current assembly such that creation and execution gas usage
 	/// is optimised according to the settings in @a _settings.
-	Assembly& optimise(OptimiserSettings const& _settings);
+	/// Sub-assemblies are optimised on up to @a _concurrency threads. The result does not
+	/// depend on the number of threads.
+	Assembly& optimise(OptimiserSettings const& _settings, size_t _concurrency = 1);
 
 	/// Create a text representation of the assembly.
 	std::string assemblyString(
@@ -179,7 +182,11 @@ protected:
 	/// Does the same operations as @a optimise, but should only be applied to a sub and
 	/// returns the replaced tags. Also takes an argument containing the tags of this assembly
 	/// that are referenced in a super-assembly.
-	std::map<u256, u256> const& optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
+	std::map<u256, u256> const& optimiseInternal(
+		OptimiserSettings const& _settings,
+		std::set<size_t> _tagsReferencedFromOutside,
+		size_t _concurrency = 1
+	);
 
 	unsigned codeSize(unsigned subTagSize) const;
 
@@ -249,6 +256,7 @@ protected:
 
 	// FIXME: This being static means that the strings won't be freed when they're no longer needed
 	static std::map<std::string, std::shared_ptr<std::string const>> s_sharedSourceNames;
+	static std::mutex s_sharedSourceNamesMutex;
 
 public:
 	size_t m_currentModifierDepth = 0;
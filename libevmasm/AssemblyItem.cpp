@@ -27,6 +27,7 @@
 #include <libsolutil/FixedHash.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <array>
 #include <fstream>
 #include <limits>
 
@@ -74,7 +75,7 @@ std::pair<std::string, std::string> AssemblyItem::nameAndData(langutil::EVMVersi
 	switch (type())
 	{
 	case Operation:
-		return {instructionInfo(instruction(), _evmVersion).name, m_data != nullptr ? toStringInHex(*m_data) : ""};
+		return {instructionInfo(instruction(), _evmVersion).name, ""};
 	case Push:
 		return {"PUSH", toStringInHex(data())};
 	case PushTag:
@@ -107,6 +108,18 @@ std::pair<std::string, std::string> AssemblyItem::nameAndData(langutil::EVMVersi
 	}
 }
 
+std::shared_ptr<u256 const> AssemblyItem::internLargeData(u256 const& _value)
+{
+	// Large constants like masks and selectors tend to repeat, so the most recent ones are kept
+	// in a small cache. It is per thread to avoid locking when assemblies are optimised in parallel.
+	static size_t constexpr cacheSize = 64;
+	thread_local std::array<std::shared_ptr<u256 const>, cacheSize> cache;
+	std::shared_ptr<u256 const>& entry = cache[std::hash<u256>{}(_value) % cacheSize];
+	if (!entry || *entry != _value)
+		entry = std::make_shared<u256 const>(_value);
+	return entry;
+}
+
 void AssemblyItem::setPushTagSubIdAndTag(size_t _subId, size_t _tag)
 {
 	assertThrow(m_type == PushTag || m_type == Tag, util::Exception, "");
@@ -29,6 +29,9 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/Numeric.h>
 #include <libsolutil/Assertions.h>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <optional>
 #include <iostream>
 #include <sstream>
@@ -69,7 +72,7 @@ public:
 		AssemblyItem(Push, std::move(_push), std::move(_debugData)) { }
 	AssemblyItem(Instruction _i, langutil::DebugData::ConstPtr _debugData = langutil::DebugData::create()):
 		m_type(Operation),
-		m_instruction(_i),
+		m_smallData(static_cast<uint8_t>(_i)),
 		m_debugData(std::move(_debugData))
 	{}
 	AssemblyItem(AssemblyItemType _type, u256 _data = 0, langutil::DebugData::ConstPtr _debugData = langutil::DebugData::create()):
@@ -77,14 +80,13 @@ public:
 		m_debugData(std::move(_debugData))
 	{
 		if (m_type == Operation)
-			m_instruction = Instruction(uint8_t(_data));
+			m_smallData = uint8_t(_data);
 		else
-			m_data = std::make_shared<u256>(std::move(_data));
+			storeData(_data);
 	}
 	explicit AssemblyItem(bytes _verbatimData, size_t _arguments, size_t _returnVariables):
 		m_type(VerbatimBytecode),
-		m_instruction{},
-		m_verbatimBytecode{{_arguments, _returnVariables, std::move(_verbatimData)}},
+		m_verbatimBytecode{std::make_shared<VerbatimBytecodeData const>(_arguments, _returnVariables, std::move(_verbatimData))},
 		m_debugData{langutil::DebugData::create()}
 	{}
 
@@ -105,8 +107,12 @@ public:
 	void setPushTagSubIdAndTag(size_t _subId, size_t _tag);
 
 	AssemblyItemType type() const { return m_type; }
-	u256 const& data() const { assertThrow(m_type != Operation, util::Exception, ""); return *m_data; }
-	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = std::make_shared<u256>(_data); }
+	u256 data() const
+	{
+		assertThrow(m_type != Operation, util::Exception, "");
+		return m_largeData ? *m_largeData : u256(m_smallData);
+	}
+	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); storeData(_data); }
 
 	/// This function is used in `Assembly::assemblyJSON`.
 	/// It returns the name & data of the current assembly item.
@@ -119,19 +125,25 @@ public:
 	bytes const& verbatimData() const { assertThrow(m_type == VerbatimBytecode, util::Exception, ""); return std::get<2>(*m_verbatimBytecode); }
 
 	/// @returns the instruction of this item (only valid if type() == Operation)
-	Instruction instruction() const { assertThrow(m_type == Operation, util::Exception, ""); return m_instruction; }
+	Instruction instruction() const
+	{
+		assertThrow(m_type == Operation, util::Exception, "");
+		return Instruction(static_cast<uint8_t>(m_smallData));
+	}
 
 	/// @returns true if the type and data of the items are equal.
 	bool operator==(AssemblyItem const& _other) const
 	{
 		if (type() != _other.type())
 			return false;
-		if (type() == Operation)
-			return instruction() == _other.instruction();
-		else if (type() == VerbatimBytecode)
+		if (type() == VerbatimBytecode)
 			return *m_verbatimBytecode == *_other.m_verbatimBytecode;
+		// Data is only stored in m_largeData if it does not fit into m_smallData,
+		// which also holds the instruction of operations.
+		else if (!m_largeData || !_other.m_largeData)
+			return !m_largeData && !_other.m_largeData && m_smallData == _other.m_smallData;
 		else
-			return data() == _other.data();
+			return *m_largeData == *_other.m_largeData;
 	}
 	bool operator!=(AssemblyItem const& _other) const { return !operator==(_other); }
 	/// Less-than operator compatible with operator==.
@@ -139,18 +151,18 @@ public:
 	{
 		if (type() != _other.type())
 			return type() < _other.type();
-		else if (type() == Operation)
-			return instruction() < _other.instruction();
 		else if (type() == VerbatimBytecode)
 			return *m_verbatimBytecode < *_other.m_verbatimBytecode;
+		else if (!m_largeData || !_other.m_largeData)
+			return _other.m_largeData || (!m_largeData && m_smallData < _other.m_smallData);
 		else
-			return data() < _other.data();
+			return *m_largeData < *_other.m_largeData;
 	}
 
 	/// Shortcut that avoids constructing an AssemblyItem just to perform the comparison.
 	bool operator==(Instruction _instr) const
 	{
-		return type() == Operation && instruction() == _instr;
+		return type() == Operation && m_smallData == static_cast<uint8_t>(_instr);
 	}
 	bool operator!=(Instruction _instr) const { return !operator==(_instr); }
 
@@ -201,8 +213,17 @@ public:
 	JumpType getJumpType() const { return m_jumpType; }
 	std::string getJumpTypeAsString() const;
 
-	void setPushedValue(u256 const& _value) const { m_pushedValue = std::make_shared<u256>(_value); }
-	u256 const* pushedValue() const { return m_pushedValue.get(); }
+	void setPushedValue(u256 const& _value) const
+	{
+		assertThrow(_value <= std::numeric_limits<uint64_t>::max(), util::Exception, "");
+		m_pushedValue = static_cast<uint64_t>(_value);
+	}
+	std::optional<u256> pushedValue() const
+	{
+		if (m_pushedValue)
+			return u256(*m_pushedValue);
+		return std::nullopt;
+	}
 
 	std::string toAssemblyText(Assembly const& _assembly) const;
 
@@ -211,19 +232,41 @@ public:
 	void setImmutableOccurrences(size_t _n) const { m_immutableOccurrences = _n; }
 
 private:
+	using VerbatimBytecodeData = std::tuple<size_t, size_t, bytes>;
+
 	size_t opcodeCount() const noexcept;
 
+	/// Stores data that fits into 64 bits inline and shares larger values between items.
+	void storeData(u256 const& _data)
+	{
+		if (_data <= std::numeric_limits<uint64_t>::max())
+		{
+			m_smallData = static_cast<uint64_t>(_data);
+			m_largeData.reset();
+		}
+		else
+		{
+			m_smallData = 0;
+			m_largeData = internLargeData(_data);
+		}
+	}
+	/// @returns a pointer to @a _value, reusing a recent allocation of the same value if possible.
+	static std::shared_ptr<u256 const> internLargeData(u256 const& _value);
+
 	AssemblyItemType m_type;
-	Instruction m_instruction; ///< Only valid if m_type == Operation
-	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
+	JumpType m_jumpType = JumpType::Ordinary;
+	/// The instruction if m_type == Operation, otherwise the data if it fits into 64 bits.
+	uint64_t m_smallData = 0;
+	/// The data if m_type != Operation and it does not fit into 64 bits.
+	/// Items are copied a lot by the optimiser, so the value is shared instead of copied.
+	std::shared_ptr<u256 const> m_largeData;
 	/// If m_type == VerbatimBytecode, this holds number of arguments, number of
 	/// return variables and verbatim bytecode.
-	std::optional<std::tuple<size_t, size_t, bytes>> m_verbatimBytecode;
+	std::shared_ptr<VerbatimBytecodeData const> m_verbatimBytecode;
 	langutil::DebugData::ConstPtr m_debugData;
-	JumpType m_jumpType = JumpType::Ordinary;
 	/// Pushed value for operations with data to be determined during assembly stage,
 	/// e.g. PushSubSize, PushTag, PushSub, etc.
-	mutable std::shared_ptr<u256> m_pushedValue;
+	mutable std::optional<uint64_t> m_pushedValue;
 	/// Number of PushImmutable's with the same hash. Only used for AssignImmutable.
 	mutable std::optional<size_t> m_immutableOccurrences;
 };
@@ -55,11 +55,22 @@ BasicBlocks ControlFlowGraph::optimisedBlocks()
 	return rebuildCode();
 }
 
+std::map<BlockId, BasicBlock> const& ControlFlowGraph::blocks()
+{
+	if (!m_items.empty())
+	{
+		findLargestTag();
+		splitBlocks();
+		resolveNextLinks();
+	}
+	return m_blocks;
+}
+
 void ControlFlowGraph::findLargestTag()
 {
 	m_lastUsedId = 0;
 	for (auto const& item: m_items)
-		if (item.type() == Tag || item.type() == PushTag)
+		if ((item.type() == Tag || item.type() == PushTag) && !isForeignTag(item))
 		{
 			// Assert that it can be converted.
 			BlockId(item.data());
@@ -86,7 +97,7 @@ void ControlFlowGraph::splitBlocks()
 			id = item.type() == Tag ? BlockId(item.data()) : generateNewId();
 			m_blocks[id].begin = static_cast<unsigned>(index);
 		}
-		if (item.type() == PushTag)
+		if (item.type() == PushTag && !isForeignTag(item))
 			m_blocks[id].pushedTags.emplace_back(item.data());
 		if (SemanticInformation::altersControlFlow(item))
 		{
@@ -122,6 +133,9 @@ void ControlFlowGraph::resolveNextLinks()
 		{
 		case BasicBlock::EndType::JUMPI:
 		case BasicBlock::EndType::HANDOVER:
+			// Execution stops at the end of the code.
+			if (block.end == m_items.size())
+				break;
 			assertThrow(
 				blockByBeginPos.count(block.end),
 				OptimizerException,
@@ -171,6 +185,8 @@ void ControlFlowGraph::setPrevLinks()
 		{
 		case BasicBlock::EndType::JUMPI:
 		case BasicBlock::EndType::HANDOVER:
+			if (!block.next)
+				break;
 			assertThrow(
 				!m_blocks.at(block.next).prev,
 				OptimizerException,
@@ -302,8 +318,10 @@ void ControlFlowGraph::gatherKnowledge()
 		block.endState = state;
 
 		if (
-			block.endType == BasicBlock::EndType::HANDOVER ||
-			block.endType == BasicBlock::EndType::JUMPI
+			block.next && (
+				block.endType == BasicBlock::EndType::HANDOVER ||
+				block.endType == BasicBlock::EndType::JUMPI
+			)
 		)
 			addWorkQueueItem(item, block.next, state);
 	}
@@ -365,6 +383,11 @@ BasicBlocks ControlFlowGraph::rebuildCode()
 	return blocks;
 }
 
+bool ControlFlowGraph::isForeignTag(AssemblyItem const& _item)
+{
+	return _item.splitForeignPushTag().first != std::numeric_limits<size_t>::max();
+}
+
 BlockId ControlFlowGraph::generateNewId()
 {
 	BlockId id = BlockId(++m_lastUsedId);
@@ -108,6 +108,10 @@ public:
 	/// @returns vector of basic blocks in the order they should be used in the final code.
 	/// Should be called only once.
 	BasicBlocks optimisedBlocks();
+	/// @returns the basic blocks of the code by their ID, with the links to the blocks control
+	/// flows into without a jump, but without any knowledge about the state.
+	/// Should be called only once and not together with optimisedBlocks().
+	std::map<BlockId, BasicBlock> const& blocks();
 
 private:
 	void findLargestTag();
@@ -119,6 +123,8 @@ private:
 	BasicBlocks rebuildCode();
 
 	BlockId generateNewId();
+	/// @returns true if @a _item refers to a tag in a different assembly.
+	static bool isForeignTag(AssemblyItem const& _item);
 
 	unsigned m_lastUsedId = 0;
 	AssemblyItems const& m_items;
@@ -0,0 +1,712 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libevmasm/DataflowGasMeter.h>
+
+#include <libevmasm/KnownState.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::evmasm;
+
+namespace
+{
+
+using GasConsumption = GasMeter::GasConsumption;
+using OptionalGas = std::optional<GasConsumption>;
+
+/// @returns the larger of the two bounds, where an empty bound means that there is no path.
+OptionalGas maxGas(OptionalGas const& _a, OptionalGas const& _b)
+{
+	if (!_a)
+		return _b;
+	if (!_b)
+		return _a;
+	return std::max(*_a, *_b);
+}
+
+/// @returns the bound of a path consisting of two parts.
+OptionalGas addGas(OptionalGas const& _a, OptionalGas const& _b)
+{
+	if (!_a || !_b)
+		return std::nullopt;
+	return *_a + *_b;
+}
+
+/// Adds a transition to @a _edges, joining it with the one to the same target if there is one.
+template <typename Edge>
+void joinEdge(std::map<BlockId, Edge>& _edges, Edge const& _edge)
+{
+	auto [it, inserted] = _edges.emplace(_edge.target, _edge);
+	if (inserted)
+		return;
+	KnownStatePointer state = it->second.state->copy();
+	state->reduceToCommonKnowledge(*_edge.state, true);
+	it->second.state = std::move(state);
+	it->second.memorySize = std::min(it->second.memorySize, _edge.memorySize);
+	it->second.gas = std::max(it->second.gas, _edge.gas);
+}
+
+}
+
+DataflowGasMeter::DataflowGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion):
+	m_items(_items),
+	m_evmVersion(_evmVersion),
+	m_graph(_items),
+	m_blocks(m_graph.blocks())
+{
+	for (auto const& [id, block]: m_blocks)
+		if (block.begin < block.end && m_items.at(block.begin).type() == Tag)
+			m_blockByTag[m_items.at(block.begin).data()] = id;
+}
+
+GasMeter::GasConsumption DataflowGasMeter::estimateMax(
+	size_t _startIndex,
+	std::shared_ptr<KnownState> const& _state
+)
+{
+	BlockId start;
+	if (_startIndex == 0 && !m_blocks.empty())
+		start = BlockId::initial();
+	else if (_startIndex < m_items.size() && m_items.at(_startIndex).type() == Tag)
+		start = m_blockByTag.at(m_items.at(_startIndex).data());
+	if (!start)
+		// Same as an invalid jump, see PathGasMeter.
+		return GasConsumption(0);
+
+	// Results cannot be reused for different initial states, since the expression classes differ.
+	m_functionResults.clear();
+	m_functionSummaries.clear();
+	m_remainingBlockVisits = maxBlockVisits;
+	Bound const& bound = analyseFunction(start, _state->copy(), 0).bound;
+	return maxGas(bound.halt, bound.ret).value_or(GasConsumption(0));
+}
+
+DataflowGasMeter::FunctionResult const& DataflowGasMeter::analyseFunction(
+	BlockId _entry,
+	std::shared_ptr<KnownState> const& _state,
+	u256 const& _memorySize
+)
+{
+	for (FunctionResult const& result: m_functionResults[_entry])
+		if (
+			result.entryMemorySize == _memorySize &&
+			result.entryState->stackHeight() == _state->stackHeight() &&
+			*result.entryState == *_state
+		)
+			return result;
+
+	m_activeFunctions.insert(_entry);
+	FunctionResult result = analyseFunctionUncached(_entry, _state, _memorySize);
+	m_activeFunctions.erase(_entry);
+	return m_functionResults[_entry].emplace_back(std::move(result));
+}
+
+DataflowGasMeter::FunctionResult DataflowGasMeter::analyseFunctionUncached(
+	BlockId _entry,
+	std::shared_ptr<KnownState> const& _state,
+	u256 const& _memorySize
+)
+{
+	struct BlockAnalysis
+	{
+		/// Knowledge about the state when this block is entered, joined over all ways to enter it.
+		KnownStatePointer startState;
+		/// Lower bound on the largest memory access before this block is entered.
+		u256 startMemorySize;
+		bool queued = false;
+		/// Result of the analysis of the block for the start state.
+		BlockResult result;
+	};
+
+	FunctionResult result;
+	result.entryState = _state;
+	result.entryMemorySize = _memorySize;
+	auto unbounded = [&]() -> FunctionResult
+	{
+		result.bound.halt = GasConsumption::infinite();
+		if (result.exitState)
+			result.bound.ret = GasConsumption::infinite();
+		return result;
+	};
+
+	// Heights of the elements of the entry stack, used to find the return address.
+	std::map<KnownState::Id, int> entryHeights;
+	for (auto const& [height, id]: _state->stackElements())
+		entryHeights.emplace(id, height);
+	bool uniformReturns = true;
+
+	std::map<BlockId, BlockAnalysis> blocks;
+	std::vector<BlockId> workQueue;
+	auto enter = [&](BlockId _block, KnownStatePointer const& _blockState, u256 const& _blockMemorySize)
+	{
+		BlockAnalysis& analysis = blocks[_block];
+		if (analysis.startState)
+		{
+			KnownStatePointer state = _blockState->copy();
+			state->reduceToCommonKnowledge(*analysis.startState, true);
+			if (*state == *analysis.startState && _blockMemorySize >= analysis.startMemorySize)
+				return;
+			analysis.startState = std::move(state);
+			analysis.startMemorySize = std::min(analysis.startMemorySize, _blockMemorySize);
+		}
+		else
+		{
+			analysis.startState = _blockState->copy();
+			analysis.startMemorySize = _blockMemorySize;
+		}
+		if (!analysis.queued)
+		{
+			analysis.queued = true;
+			workQueue.push_back(_block);
+		}
+	};
+
+	// Propagate the knowledge about the state until nothing changes anymore.
+	enter(_entry, _state, _memorySize);
+	while (!workQueue.empty())
+	{
+		if (m_remainingBlockVisits == 0)
+		{
+			result.bound.halt = GasConsumption::infinite();
+			return result;
+		}
+		--m_remainingBlockVisits;
+
+		BlockId const id = workQueue.back();
+		workQueue.pop_back();
+		BlockAnalysis& analysis = blocks.at(id);
+		analysis.queued = false;
+		analysis.result = analyseBlock(id, analysis.startState, analysis.startMemorySize);
+		BlockResult const& blockResult = analysis.result;
+
+		result.lowestChangedHeight = std::min(result.lowestChangedHeight, blockResult.lowestChangedHeight);
+		if (blockResult.exitState)
+		{
+			std::optional<int> returnAddressHeight;
+			if (entryHeights.count(blockResult.returnAddress))
+				returnAddressHeight = entryHeights.at(blockResult.returnAddress);
+			result.returnTags.insert(blockResult.returnTags.begin(), blockResult.returnTags.end());
+			if (result.exitState)
+			{
+				if (
+					result.exitState->stackHeight() != blockResult.exitState->stackHeight() ||
+					result.returnAddressHeight != returnAddressHeight
+				)
+					uniformReturns = false;
+				result.exitState->reduceToCommonKnowledge(*blockResult.exitState, true);
+				result.exitMemorySize = std::min(result.exitMemorySize, blockResult.exitMemorySize);
+			}
+			else
+			{
+				result.exitState = blockResult.exitState->copy();
+				result.exitMemorySize = blockResult.exitMemorySize;
+				result.returnAddressHeight = returnAddressHeight;
+			}
+		}
+		for (Edge const& edge: blockResult.edges)
+			enter(edge.target, edge.state, edge.memorySize);
+	}
+	if (!uniformReturns)
+		result.returnAddressHeight.reset();
+
+	// Every edge to a block on the current path of a depth-first search leads to the header of a loop.
+	std::map<BlockId, std::set<BlockId>> latches;
+	std::map<BlockId, std::set<BlockId>> predecessors;
+	{
+		std::set<BlockId> visited{_entry};
+		std::set<BlockId> onPath{_entry};
+		std::vector<std::pair<BlockId, size_t>> stack{{_entry, 0}};
+		while (!stack.empty())
+		{
+			BlockId const id = stack.back().first;
+			std::vector<Edge> const& edges = blocks.at(id).result.edges;
+			if (stack.back().second < edges.size())
+			{
+				BlockId const successor = edges[stack.back().second++].target;
+				predecessors[successor].insert(id);
+				if (onPath.count(successor))
+					latches[successor].insert(id);
+				else if (visited.insert(successor).second)
+				{
+					onPath.insert(successor);
+					stack.emplace_back(successor, 0);
+				}
+				continue;
+			}
+			onPath.erase(id);
+			stack.pop_back();
+		}
+	}
+
+	// The body of a loop consists of the blocks from which a latch can be reached without passing
+	// the header. Loops with further entries cannot be executed iteration by iteration.
+	std::map<BlockId, Loop> loops;
+	for (auto const& [header, headerLatches]: latches)
+	{
+		Loop& loop = loops[header];
+		loop.header = header;
+		loop.body = {header};
+		std::vector<BlockId> toVisit(headerLatches.begin(), headerLatches.end());
+		while (!toVisit.empty())
+		{
+			BlockId const id = toVisit.back();
+			toVisit.pop_back();
+			if (!loop.body.insert(id).second)
+				continue;
+			if (id == _entry)
+				return unbounded();
+			toVisit.insert(toVisit.end(), predecessors[id].begin(), predecessors[id].end());
+		}
+	}
+	for (auto& [header, loop]: loops)
+		for (auto const& [otherHeader, otherLoop]: loops)
+			if (otherHeader != header && otherLoop.body.count(header))
+			{
+				if (!std::includes(otherLoop.body.begin(), otherLoop.body.end(), loop.body.begin(), loop.body.end()))
+					return unbounded();
+				if (!loop.parent || otherLoop.body.size() < loop.parent->body.size())
+					loop.parent = &otherLoop;
+			}
+
+	// Orders the blocks of a loop, or of the whole function if the loop is null, where the
+	// outermost inner loops are represented by their headers and edges back to the header of the
+	// loop are ignored. Fails if these edges do not form a directed acyclic graph.
+	auto regionOrder = [&](Loop const* _region, BlockId _start) -> std::optional<std::vector<BlockId>>
+	{
+		auto successors = [&](BlockId _node)
+		{
+			Loop const* innerLoop = (loops.count(_node) && &loops.at(_node) != _region) ? &loops.at(_node) : nullptr;
+			std::set<BlockId> targets;
+			for (BlockId block: innerLoop ? innerLoop->body : std::set<BlockId>{_node})
+				for (Edge const& edge: blocks.at(block).result.edges)
+					if (
+						!(innerLoop && innerLoop->body.count(edge.target)) &&
+						!(_region && (edge.target == _region->header || !_region->body.count(edge.target)))
+					)
+						targets.insert(regionNode(_region, edge.target, loops));
+			return std::vector<BlockId>(targets.begin(), targets.end());
+		};
+
+		std::vector<BlockId> order;
+		std::set<BlockId> visited{_start};
+		std::set<BlockId> onPath{_start};
+		std::vector<std::pair<BlockId, std::vector<BlockId>>> stack;
+		stack.emplace_back(_start, successors(_start));
+		while (!stack.empty())
+		{
+			if (!stack.back().second.empty())
+			{
+				BlockId const successor = stack.back().second.back();
+				stack.back().second.pop_back();
+				if (onPath.count(successor))
+					return std::nullopt;
+				if (visited.insert(successor).second)
+				{
+					onPath.insert(successor);
+					stack.emplace_back(successor, successors(successor));
+				}
+				continue;
+			}
+			onPath.erase(stack.back().first);
+			order.push_back(stack.back().first);
+			stack.pop_back();
+		}
+		std::reverse(order.begin(), order.end());
+		return order;
+	};
+	for (auto& [header, loop]: loops)
+		if (std::optional<std::vector<BlockId>> order = regionOrder(&loop, header))
+			loop.iterationOrder = std::move(*order);
+		else
+			return unbounded();
+	std::optional<std::vector<BlockId>> order = regionOrder(nullptr, regionNode(nullptr, _entry, loops));
+	if (!order)
+		return unbounded();
+
+	// Find the costliest paths, where loops are executed for the state at their entry.
+	std::map<BlockId, Bound> bounds;
+	for (auto it = order->rbegin(); it != order->rend(); ++it)
+	{
+		BlockId const node = *it;
+		Bound bound;
+		std::vector<Edge> edges;
+		if (loops.count(node))
+		{
+			// Join the knowledge about the state over the ways to enter the loop.
+			std::map<BlockId, Edge> entries;
+			if (node == _entry)
+				joinEdge(entries, Edge{node, _state, _memorySize, GasConsumption(0)});
+			for (BlockId predecessor: predecessors[node])
+				if (!loops.at(node).body.count(predecessor))
+					for (Edge const& edge: blocks.at(predecessor).result.edges)
+						if (edge.target == node)
+							joinEdge(entries, edge);
+			Edge const& entry = entries.at(node);
+			std::optional<LoopResult> loopResult = analyseLoop(loops.at(node), loops, entry.state, entry.memorySize);
+			if (!loopResult)
+				return unbounded();
+			bound = loopResult->bound;
+			for (auto const& exit: loopResult->exits)
+				edges.emplace_back(exit.second);
+		}
+		else
+		{
+			BlockResult const& blockResult = blocks.at(node).result;
+			bound.halt = blockResult.halt;
+			if (blockResult.exitState)
+				bound.ret = GasConsumption(0);
+			for (Edge const& edge: blockResult.edges)
+				edges.emplace_back(edge);
+		}
+		for (Edge const& edge: edges)
+		{
+			auto after = bounds.find(regionNode(nullptr, edge.target, loops));
+			if (after == bounds.end())
+				// Only the execution of a loop found this way.
+				return unbounded();
+			bound.halt = maxGas(bound.halt, addGas(edge.gas, after->second.halt));
+			bound.ret = maxGas(bound.ret, addGas(edge.gas, after->second.ret));
+		}
+		if (!loops.count(node))
+		{
+			bound.halt = addGas(blocks.at(node).result.gas, bound.halt);
+			bound.ret = addGas(blocks.at(node).result.gas, bound.ret);
+		}
+		bounds[node] = bound;
+	}
+
+	result.bound = bounds.at(order->front());
+	return result;
+}
+
+DataflowGasMeter::FunctionResult const& DataflowGasMeter::functionSummary(BlockId _entry)
+{
+	if (!m_functionSummaries.count(_entry))
+	{
+		// The values the function leaves on the stack are expressed in terms of these elements.
+		auto state = std::make_shared<KnownState>();
+		state->feedItem(AssemblyItem(bytes{}, 0, static_cast<size_t>(summaryStackHeight)));
+		m_activeFunctions.insert(_entry);
+		FunctionResult summary = analyseFunctionUncached(_entry, state, 0);
+		m_activeFunctions.erase(_entry);
+		m_functionSummaries.emplace(_entry, std::move(summary));
+	}
+	return m_functionSummaries.at(_entry);
+}
+
+std::shared_ptr<KnownState> DataflowGasMeter::applySummary(
+	FunctionResult const& _summary,
+	KnownState const& _state,
+	int _lowestReplacedHeight
+)
+{
+	using Id = KnownState::Id;
+	KnownStatePointer state = _state.copy();
+	ExpressionClasses const& summaryClasses = _summary.entryState->expressionClasses();
+	int const height = state->stackHeight();
+
+	// Expressions of the summary in terms of the stack at the call, if they can be translated.
+	std::map<Id, std::optional<Id>> translated;
+	for (auto const& [entryHeight, id]: _summary.entryState->stackElements())
+		translated[id] = state->stackElement(height + entryHeight - summaryStackHeight, {});
+	std::function<std::optional<Id>(Id)> translate = [&](Id _id) -> std::optional<Id>
+	{
+		if (translated.count(_id))
+			return translated.at(_id);
+		ExpressionClasses::Expression const& expression = summaryClasses.representative(_id);
+		std::optional<Id> result;
+		// Unknown values and values that depend on storage or memory cannot be translated.
+		if (expression.item && expression.item->type() != UndefinedItem && expression.sequenceNumber == 0)
+		{
+			ExpressionClasses::Ids arguments;
+			for (Id argument: expression.arguments)
+				if (std::optional<Id> translatedArgument = translate(argument))
+					arguments.push_back(*translatedArgument);
+			if (arguments.size() == expression.arguments.size())
+				result = state->expressionClasses().find(*expression.item, arguments);
+		}
+		return translated[_id] = result;
+	};
+
+	int const lowest = _lowestReplacedHeight;
+	int const exitHeight = _summary.exitState->stackHeight() - summaryStackHeight;
+	solAssert(lowest <= 1 && lowest <= exitHeight + 1);
+	std::map<int, Id> exitElements;
+	for (int exitElement = lowest; exitElement <= exitHeight; ++exitElement)
+		if (_summary.exitState->stackElements().count(exitElement + summaryStackHeight))
+			if (std::optional<Id> id = translate(_summary.exitState->stackElements().at(exitElement + summaryStackHeight)))
+				exitElements[height + exitElement] = *id;
+
+	// Anything else about the state may have been changed by the function, like by verbatim code.
+	state->feedItem(AssemblyItem(
+		bytes{},
+		static_cast<size_t>(1 - lowest),
+		static_cast<size_t>(exitHeight - lowest + 1)
+	));
+	for (auto const& [exitElementHeight, id]: exitElements)
+		state->setStackElement(exitElementHeight, id);
+	return state;
+}
+
+DataflowGasMeter::BlockResult DataflowGasMeter::analyseBlock(
+	BlockId _block,
+	std::shared_ptr<KnownState> const& _state,
+	u256 const& _memorySize
+)
+{
+	BasicBlock const& block = m_blocks.at(_block);
+	BlockResult result;
+
+	KnownStatePointer state = _state->copy();
+	GasMeter meter(state, m_evmVersion, _memorySize);
+	ExpressionClasses& classes = state->expressionClasses();
+
+	// The tags are only known before the final jump is fed to the state.
+	std::set<u256> jumpTags;
+	bool unknownJumpTarget = false;
+	bool continues = (block.endType == BasicBlock::EndType::HANDOVER);
+	for (unsigned index = block.begin; index < block.end; ++index)
+	{
+		AssemblyItem const& item = m_items.at(index);
+		if (index + 1 == block.end && block.endType == BasicBlock::EndType::JUMP)
+		{
+			result.returnAddress = state->relativeStackElement(0);
+			jumpTags = state->tagsInExpression(result.returnAddress);
+			unknownJumpTarget = jumpTags.empty();
+		}
+		else if (index + 1 == block.end && block.endType == BasicBlock::EndType::JUMPI)
+		{
+			ExpressionClasses::Id condition = state->relativeStackElement(-1);
+			if (!classes.knownZero(condition))
+			{
+				jumpTags = state->tagsInExpression(state->relativeStackElement(0));
+				unknownJumpTarget = jumpTags.empty();
+			}
+			continues = !classes.knownNonZero(condition);
+		}
+		if (!SemanticInformation::isDupInstruction(item) && item.arguments() > 0)
+			result.lowestChangedHeight = std::min(
+				result.lowestChangedHeight,
+				state->stackHeight() + 1 - static_cast<int>(item.arguments())
+			);
+		result.gas += meter.estimateMax(item);
+	}
+	u256 const memorySize = meter.largestMemoryAccess();
+
+	AssemblyItem::JumpType jumpType = AssemblyItem::JumpType::Ordinary;
+	if (block.endType == BasicBlock::EndType::JUMP)
+		jumpType = m_items.at(block.end - 1).getJumpType();
+
+	if (jumpType == AssemblyItem::JumpType::OutOfFunction)
+	{
+		// The return address is usually not known in the summary of a function.
+		result.exitState = state;
+		result.exitMemorySize = memorySize;
+		result.returnTags = jumpTags;
+	}
+	else if (unknownJumpTarget)
+	{
+		result.gas = GasConsumption::infinite();
+		result.halt = GasConsumption(0);
+	}
+	else if (jumpType == AssemblyItem::JumpType::IntoFunction)
+	{
+		// Both code generators place the return label directly after the jump. It has to be on the
+		// stack for the called function to return to it.
+		std::optional<u256> returnTag;
+		if (block.end < m_items.size() && m_items.at(block.end).type() == Tag)
+			for (auto const& stackElement: state->stackElements())
+				if (state->tagsInExpression(stackElement.second).count(m_items.at(block.end).data()))
+					returnTag = m_items.at(block.end).data();
+
+		for (u256 const& tag: jumpTags)
+		{
+			if (!m_blockByTag.count(tag))
+			{
+				// Invalid jumps stop the execution.
+				result.halt = maxGas(result.halt, GasConsumption(0));
+				continue;
+			}
+			BlockId const callee = m_blockByTag.at(tag);
+			if (m_activeFunctions.count(callee))
+			{
+				// The depth of the recursion is not known.
+				result.halt = GasConsumption::infinite();
+				continue;
+			}
+
+			FunctionResult const& summary = functionSummary(callee);
+			bool const bounded =
+				!(summary.bound.halt && summary.bound.halt->isInfinite) &&
+				!(summary.bound.ret && summary.bound.ret->isInfinite);
+			if (bounded && !summary.bound.ret)
+			{
+				result.halt = maxGas(result.halt, summary.bound.halt);
+				continue;
+			}
+			if (
+				bounded &&
+				returnTag &&
+				summary.returnAddressHeight &&
+				state->tagsInExpression(state->stackElement(
+					state->stackHeight() + *summary.returnAddressHeight - summaryStackHeight,
+					{}
+				)) == std::set<u256>{*returnTag}
+			)
+			{
+				// The elements from this height up are replaced by the ones the function returns with.
+				int const lowestReplacedHeight = std::min({
+					summary.lowestChangedHeight - summaryStackHeight,
+					summary.exitState->stackHeight() - summaryStackHeight + 1,
+					1
+				});
+				result.halt = maxGas(result.halt, summary.bound.halt);
+				result.lowestChangedHeight = std::min(
+					result.lowestChangedHeight,
+					state->stackHeight() + lowestReplacedHeight
+				);
+				result.edges.push_back({
+					m_blockByTag.at(*returnTag),
+					applySummary(summary, *state, lowestReplacedHeight),
+					std::max(memorySize, summary.exitMemorySize),
+					*summary.bound.ret
+				});
+				continue;
+			}
+
+			// Analyse the function for the state at this call, which may bound loops that depend on
+			// the arguments.
+			FunctionResult const& function = analyseFunction(callee, state, memorySize);
+			result.halt = maxGas(result.halt, function.bound.halt);
+			result.lowestChangedHeight = std::min(result.lowestChangedHeight, function.lowestChangedHeight);
+			if (!function.bound.ret)
+				continue;
+			if (returnTag && function.returnTags == std::set<u256>{*returnTag})
+				result.edges.push_back({
+					m_blockByTag.at(*returnTag),
+					function.exitState,
+					function.exitMemorySize,
+					*function.bound.ret
+				});
+			else
+				// We do not know where the execution continues.
+				result.halt = GasConsumption::infinite();
+		}
+	}
+	else
+	{
+		for (u256 const& tag: jumpTags)
+			if (m_blockByTag.count(tag))
+				result.edges.push_back({m_blockByTag.at(tag), state, memorySize, GasConsumption(0)});
+			else
+				// Invalid jumps stop the execution.
+				result.halt = GasConsumption(0);
+		if (continues && block.next)
+			result.edges.push_back({block.next, state, memorySize, GasConsumption(0)});
+		else if (continues || block.endType == BasicBlock::EndType::STOP)
+			result.halt = GasConsumption(0);
+	}
+	return result;
+}
+
+std::optional<DataflowGasMeter::LoopResult> DataflowGasMeter::analyseLoop(
+	Loop const& _loop,
+	std::map<BlockId, Loop> const& _loops,
+	std::shared_ptr<KnownState> const& _state,
+	u256 const& _memorySize
+)
+{
+	LoopResult result;
+	Edge entry{_loop.header, _state, _memorySize, GasConsumption(0)};
+	for (size_t iteration = 0; iteration < maxLoopIterations; ++iteration)
+	{
+		std::map<BlockId, Edge> incoming{{_loop.header, entry}};
+		std::map<BlockId, Edge> next;
+		auto route = [&](Edge const& _edge)
+		{
+			if (_edge.target == _loop.header)
+				joinEdge(next, _edge);
+			else if (_loop.body.count(_edge.target))
+				joinEdge(incoming, _edge);
+			else
+				joinEdge(result.exits, _edge);
+		};
+
+		for (BlockId node: _loop.iterationOrder)
+		{
+			auto it = incoming.find(node);
+			if (it == incoming.end())
+				continue;
+			Edge const in = std::move(it->second);
+			incoming.erase(it);
+			if (node != _loop.header && _loops.count(node))
+			{
+				std::optional<LoopResult> innerResult = analyseLoop(_loops.at(node), _loops, in.state, in.memorySize);
+				if (!innerResult)
+					return std::nullopt;
+				result.bound.halt = maxGas(result.bound.halt, addGas(in.gas, innerResult->bound.halt));
+				result.bound.ret = maxGas(result.bound.ret, addGas(in.gas, innerResult->bound.ret));
+				for (auto const& [target, exit]: innerResult->exits)
+					route({target, exit.state, exit.memorySize, in.gas + exit.gas});
+			}
+			else
+			{
+				if (m_remainingBlockVisits == 0)
+					return std::nullopt;
+				--m_remainingBlockVisits;
+				BlockResult const blockResult = analyseBlock(node, in.state, in.memorySize);
+				GasConsumption const gas = in.gas + blockResult.gas;
+				result.bound.halt = maxGas(result.bound.halt, addGas(gas, blockResult.halt));
+				if (blockResult.exitState)
+					result.bound.ret = maxGas(result.bound.ret, gas);
+				for (Edge const& edge: blockResult.edges)
+					route({edge.target, edge.state, edge.memorySize, gas + edge.gas});
+			}
+		}
+		if (!incoming.empty())
+			// The iteration entered a block in an order the analysis of the whole function did not find.
+			return std::nullopt;
+		if (next.empty())
+			return result;
+
+		Edge const& nextEntry = next.at(_loop.header);
+		if (
+			nextEntry.memorySize == entry.memorySize &&
+			nextEntry.state->stackHeight() == entry.state->stackHeight() &&
+			*nextEntry.state == *entry.state
+		)
+			// Nothing is known to change from one iteration to the next.
+			return std::nullopt;
+		entry = nextEntry;
+	}
+	return std::nullopt;
+}
+
+BlockId DataflowGasMeter::regionNode(Loop const* _region, BlockId _block, std::map<BlockId, Loop> const& _loops)
+{
+	for (auto const& [header, loop]: _loops)
+		if (loop.parent == _region && loop.body.count(_block))
+			return header;
+	return _block;
+}
@@ -0,0 +1,228 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Upper bound on the gas usage of a computation, computed by a dataflow analysis over the
+ * control flow graph.
+ */
+
+#pragma once
+
+#include <libevmasm/ControlFlowGraph.h>
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/KnownState.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace solidity::evmasm
+{
+
+/**
+ * Computes an upper bound on the gas usage of a computation starting at a certain position in
+ * a list of AssemblyItems in a given state until the computation stops, like PathGasMeter,
+ * but without enumerating the paths through the code.
+ *
+ * The knowledge about the state is propagated along the edges of the control flow graph and
+ * joined where paths meet, so that every block is analysed a few times at most. The bound is
+ * then the costliest path through the graph.
+ *
+ * Jumps into functions continue at the tag that directly follows the jump, which is where both
+ * code generators place the return label. Every function is first analysed once for a stack
+ * about which nothing is known. This summary provides a bound that holds for every call and
+ * the values the function leaves on the stack in terms of the ones it starts with, which are
+ * translated to the state at each call. If the summary is unbounded, e.g. because the number of
+ * iterations of a loop depends on an argument, or if the return address cannot be found, the
+ * function is analysed again for the state at the call.
+ *
+ * Loops are executed iteration by iteration on the knowledge about the state. This terminates
+ * for loops whose condition becomes known to be false after a number of iterations, i.e. loops
+ * with a constant number of iterations. Any other loop that is reachable makes the bound infinite.
+ */
+class DataflowGasMeter
+{
+public:
+	explicit DataflowGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion);
+
+	GasMeter::GasConsumption estimateMax(size_t _startIndex, std::shared_ptr<KnownState> const& _state);
+
+	static GasMeter::GasConsumption estimateMax(
+		AssemblyItems const& _items,
+		langutil::EVMVersion _evmVersion,
+		size_t _startIndex,
+		std::shared_ptr<KnownState> const& _state
+	)
+	{
+		return DataflowGasMeter(_items, _evmVersion).estimateMax(_startIndex, _state);
+	}
+
+	/// Maximum number of times blocks are analysed in one call to estimateMax. If the analysis
+	/// needs more, the gas usage is reported as infinite.
+	static size_t constexpr maxBlockVisits = 20000;
+	/// Maximum number of iterations of a loop that are analysed. Loops with more iterations are
+	/// reported as infinite.
+	static size_t constexpr maxLoopIterations = 1000;
+
+private:
+	/// Height of the stack the summaries of functions are computed for, relative to which the
+	/// return address and the arguments have to be found.
+	static int constexpr summaryStackHeight = 32;
+
+	/// Upper bounds on the gas used from a point in a function until the execution stops
+	/// and until the function returns. Empty if there is no such path.
+	struct Bound
+	{
+		std::optional<GasMeter::GasConsumption> halt;
+		std::optional<GasMeter::GasConsumption> ret;
+	};
+
+	/// Transition from the end of a block to a block of the same function.
+	struct Edge
+	{
+		BlockId target;
+		/// Knowledge about the state when the target is entered.
+		std::shared_ptr<KnownState> state;
+		/// Lower bound on the largest memory access when the target is entered.
+		u256 memorySize;
+		/// Gas used between the start of the transition and the target, e.g. by a called function.
+		GasMeter::GasConsumption gas;
+	};
+
+	/// Result of the analysis of a block for a certain state at its start.
+	struct BlockResult
+	{
+		/// Gas used by the items of the block.
+		GasMeter::GasConsumption gas;
+		std::vector<Edge> edges;
+		/// Gas used after the items of the block until the execution stops, if it can stop there.
+		std::optional<GasMeter::GasConsumption> halt;
+		/// Knowledge about the state after returning from the function at the end of the block,
+		/// null if it does not return there.
+		std::shared_ptr<KnownState> exitState;
+		u256 exitMemorySize;
+		/// Tags the function returns to.
+		std::set<u256> returnTags;
+		/// Equivalence class of the address the function returns to.
+		KnownState::Id returnAddress = 0;
+		/// Lowest stack height that is changed by the block or the functions it calls.
+		int lowestChangedHeight = std::numeric_limits<int>::max();
+	};
+
+	/// Result of the analysis of a function for a certain state at its entry.
+	struct FunctionResult
+	{
+		std::shared_ptr<KnownState> entryState;
+		u256 entryMemorySize;
+		Bound bound;
+		/// Knowledge about the state after returning from the function, null if it never returns.
+		std::shared_ptr<KnownState> exitState;
+		u256 exitMemorySize;
+		/// Tags the function returns to.
+		std::set<u256> returnTags;
+		/// Height in the entry state of the address the function returns to, if it is the same
+		/// for all returns and the stack height after returning is the same as well.
+		std::optional<int> returnAddressHeight;
+		/// Lowest stack height that is changed by the function.
+		int lowestChangedHeight = std::numeric_limits<int>::max();
+	};
+
+	/// Blocks of a function that are only entered through the header and from which the header
+	/// can be reached again.
+	struct Loop
+	{
+		BlockId header;
+		std::set<BlockId> body;
+		/// Innermost loop that contains this one, if any.
+		Loop const* parent = nullptr;
+		/// Blocks of the body that are not part of an inner loop and the headers of the outermost
+		/// inner loops, in the order of an iteration.
+		std::vector<BlockId> iterationOrder;
+	};
+
+	/// Result of the analysis of a loop for a certain state at the entry of its header.
+	struct LoopResult
+	{
+		/// Gas used from the entry until the execution stops or the function returns in the loop.
+		Bound bound;
+		/// Transitions to the blocks after the loop, by target, where the gas is counted from the entry.
+		std::map<BlockId, Edge> exits;
+	};
+
+	/// @returns the result of the analysis of the function starting at @a _entry, reusing
+	/// the result for an equal state if there is one.
+	FunctionResult const& analyseFunction(
+		BlockId _entry,
+		std::shared_ptr<KnownState> const& _state,
+		u256 const& _memorySize
+	);
+	FunctionResult analyseFunctionUncached(
+		BlockId _entry,
+		std::shared_ptr<KnownState> const& _state,
+		u256 const& _memorySize
+	);
+	/// @returns the result of the analysis of the function starting at @a _entry for a stack of
+	/// unknown elements, see summaryStackHeight.
+	FunctionResult const& functionSummary(BlockId _entry);
+	/// @returns the knowledge about the state after the function with the given summary is called
+	/// in state @a _state and returns, where the elements relative to the stack height at the
+	/// call from @a _lowestReplacedHeight up are the ones the function returns with.
+	std::shared_ptr<KnownState> applySummary(
+		FunctionResult const& _summary,
+		KnownState const& _state,
+		int _lowestReplacedHeight
+	);
+	/// @returns the result of executing the items of block @a _block in the given state.
+	BlockResult analyseBlock(
+		BlockId _block,
+		std::shared_ptr<KnownState> const& _state,
+		u256 const& _memorySize
+	);
+	/// @returns the result of executing the loop iteration by iteration starting with the given
+	/// state, or nullopt if the number of iterations is not known.
+	std::optional<LoopResult> analyseLoop(
+		Loop const& _loop,
+		std::map<BlockId, Loop> const& _loops,
+		std::shared_ptr<KnownState> const& _state,
+		u256 const& _memorySize
+	);
+	/// @returns the header of the outermost loop inside @a _region that contains @a _block, or
+	/// @a _block itself if there is none. The region is the whole function if it is null.
+	static BlockId regionNode(Loop const* _region, BlockId _block, std::map<BlockId, Loop> const& _loops);
+
+	AssemblyItems const& m_items;
+	langutil::EVMVersion m_evmVersion;
+	ControlFlowGraph m_graph;
+	std::map<BlockId, BasicBlock> const& m_blocks;
+	/// Blocks that start with a tag, by the tag.
+	std::map<u256, BlockId> m_blockByTag;
+	/// Results of analyses of functions, by their entry block.
+	std::map<BlockId, std::deque<FunctionResult>> m_functionResults;
+	/// Results of analyses of functions for a stack of unknown elements, by their entry block.
+	std::map<BlockId, FunctionResult> m_functionSummaries;
+	/// Functions that are currently being analysed, used to detect recursion.
+	std::set<BlockId> m_activeFunctions;
+	size_t m_remainingBlockVisits = maxBlockVisits;
+};
+
+}
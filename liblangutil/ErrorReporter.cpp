@@ -37,6 +37,21 @@ ErrorReporter& ErrorReporter::operator=(ErrorReporter const& _errorReporter)
 	return *this;
 }
 
+bool ErrorReporter::appendWithinLimits(ErrorList const& _errorList)
+{
+	try
+	{
+		for (auto const& error: _errorList)
+			if (!checkForExcessiveErrors(error->type()))
+				m_errorList.push_back(error);
+	}
+	catch (FatalError const&)
+	{
+		return false;
+	}
+	return true;
+}
+
 void ErrorReporter::warning(ErrorId _error, std::string const& _description)
 {
 	error(_error, Error::Type::Warning, SourceLocation(), _description);
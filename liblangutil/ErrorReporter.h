@@ -53,6 +53,11 @@ public:
 		m_errorList += _errorList;
 	}
 
+	/// Adds the errors one after the other as if they had been reported to this reporter,
+	/// so that the limits on the number of errors, warnings and infos apply to them as well.
+	/// @returns false if there are too many errors, in which case the rest is dropped.
+	bool appendWithinLimits(ErrorList const& _errorList);
+
 	void warning(ErrorId _error, std::string const& _description);
 
 	void warning(ErrorId _error, SourceLocation const& _location, std::string const& _description);
@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+
+#include <fstream>
+
+using namespace solidity;
+using namespace solidity::frontend;
+
+std::optional<Json> CompilationCache::load(util::h256 const& _key) const
+{
+	boost::filesystem::path path = entryPath(_key);
+	boost::system::error_code errorCode;
+	if (!boost::filesystem::is_regular_file(path, errorCode))
+		return std::nullopt;
+
+	try
+	{
+		Json value;
+		if (util::jsonParseStrict(util::readFileAsString(path), value))
+			return value;
+	}
+	catch (util::FileNotFound const&)
+	{
+	}
+	catch (util::NotAFile const&)
+	{
+	}
+	return std::nullopt;
+}
+
+void CompilationCache::store(util::h256 const& _key, Json const& _value) const
+{
+	boost::system::error_code errorCode;
+	boost::filesystem::create_directories(m_directory, errorCode);
+	if (errorCode)
+		return;
+
+	boost::filesystem::path path = entryPath(_key);
+	boost::filesystem::path temporaryPath = path;
+	temporaryPath += boost::filesystem::unique_path(".%%%%-%%%%-%%%%-%%%%.tmp", errorCode);
+	if (errorCode)
+		return;
+
+	std::ofstream file(temporaryPath.string(), std::ios::binary | std::ios::trunc);
+	file << util::jsonCompactPrint(_value);
+	file.close();
+	if (file.fail())
+	{
+		boost::filesystem::remove(temporaryPath, errorCode);
+		return;
+	}
+
+	// Renaming is atomic, so concurrent readers never see a partially written entry.
+	boost::filesystem::rename(temporaryPath, path, errorCode);
+	if (errorCode)
+		boost::filesystem::remove(temporaryPath, errorCode);
+}
+
+boost::filesystem::path CompilationCache::entryPath(util::h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".json");
+}
@@ -0,0 +1,59 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Persistent on-disk cache for compilation outputs.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+
+#include <optional>
+
+namespace solidity::frontend
+{
+
+/**
+ * Stores JSON values in a directory on disk, one file per key.
+ *
+ * Entries are written to a temporary file first and then moved into place, so the directory
+ * can be shared by compiler processes running at the same time. The cache is only an
+ * optimization: a failure to read or write an entry makes it behave like a missing entry.
+ */
+class CompilationCache
+{
+public:
+	explicit CompilationCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the value stored under @a _key or nullopt if there is no (readable) entry.
+	std::optional<Json> load(util::h256 const& _key) const;
+	/// Stores @a _value under @a _key, replacing any existing entry.
+	void store(util::h256 const& _key, Json const& _value) const;
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
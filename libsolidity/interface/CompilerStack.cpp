@@ -84,6 +84,7 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/Parallel.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
@@ -93,6 +94,7 @@
 
 #include <fmt/format.h>
 
+#include <exception>
 #include <utility>
 #include <map>
 #include <limits>
@@ -249,6 +251,28 @@ void CompilerStack::setModelCheckerSettings(ModelCheckerSettings _settings)
 	m_modelCheckerSettings = _settings;
 }
 
+void CompilerStack::setParallelism(size_t _parallelism)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must set parallelism before compiling.");
+	solAssert(_parallelism > 0, "Parallelism must be at least one.");
+	m_parallelism = _parallelism;
+}
+
+void CompilerStack::enableTimeReport(bool _enable)
+{
+	solAssert(m_stackState < ParsedAndImported, "Must enable the time report before parsing.");
+	if (!_enable)
+		m_timeReport.reset();
+	else if (!m_timeReport)
+		m_timeReport = std::make_unique<util::TimeReport>();
+}
+
+void CompilerStack::enableOptimiserStepProfile(bool _enable)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must enable the optimiser step profile before compiling.");
+	m_optimiserStepProfile = _enable;
+}
+
 void CompilerStack::setLibraries(std::map<std::string, util::h160> const& _libraries)
 {
 	solAssert(m_stackState < ParsedAndImported, "Must set libraries before parsing.");
@@ -314,17 +338,24 @@ void CompilerStack::reset(bool _keepSettings)
 		m_evmVersion = langutil::EVMVersion();
 		m_modelCheckerSettings = ModelCheckerSettings{};
 		m_generateIR = false;
+		m_parallelism = 1;
 		m_revertStrings = RevertStrings::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
 		m_metadataFormat = defaultMetadataFormat();
 		m_metadataHash = MetadataHash::IPFS;
 		m_stopAfter = State::CompilationSuccessful;
+		m_timeReport.reset();
+		m_optimiserStepProfile = false;
+		m_gasEstimationEngine = GasEstimationEngine::Path;
 	}
+	else if (m_timeReport)
+		m_timeReport = std::make_unique<util::TimeReport>();
 	m_experimentalAnalysis.reset();
 	m_globalContext.reset();
 	m_sourceOrder.clear();
 	m_contracts.clear();
+	m_optimizedYulCodeCache.reset();
 	m_errorReporter.clear();
 	TypeProvider::reset();
 }
@@ -338,9 +369,28 @@ void CompilerStack::setSources(StringMap _sources)
 	m_stackState = SourcesSet;
 }
 
+/// A source parsed on a worker thread, with its own parser and diagnostics.
+struct CompilerStack::ParsedAhead
+{
+	ParsedAhead(EVMVersion _evmVersion, std::shared_ptr<CharStream> _charStream):
+		errorReporter(errors),
+		// The IDs are only known once the sources parsed before are numbered.
+		parser(errorReporter, _evmVersion, 0, true),
+		charStream(std::move(_charStream))
+	{}
+
+	ErrorList errors;
+	ErrorReporter errorReporter;
+	Parser parser;
+	std::shared_ptr<CharStream> charStream;
+	ASTPointer<SourceUnit> ast;
+	std::exception_ptr exception;
+};
+
 bool CompilerStack::parse()
 {
 	solAssert(m_stackState == SourcesSet, "Must call parse only after the SourcesSet state.");
+	util::TimeReport::Stage stage(m_timeReport.get(), "Parsing");
 	m_errorReporter.clear();
 
 	if (SemVerVersion{std::string(VersionString)}.isPrerelease())
@@ -348,17 +398,52 @@ bool CompilerStack::parse()
 
 	try
 	{
-		Parser parser{m_errorReporter, m_evmVersion};
+		int64_t maxID = 0;
 
 		std::vector<std::string> sourcesToParse;
 		for (auto const& s: m_sources)
 			sourcesToParse.push_back(s.first);
 
+		// Sources are parsed in waves: The imports of a wave are only known once it is parsed
+		// and form the next wave. With parallelism, the sources of a wave are parsed on worker
+		// threads first. They are then processed in order exactly as if they had been parsed
+		// one after the other, so that diagnostics and node IDs do not depend on the parallelism.
+		std::map<size_t, std::unique_ptr<ParsedAhead>> parsedAhead;
+		size_t nextWave = 0;
+
 		for (size_t i = 0; i < sourcesToParse.size(); ++i)
 		{
+			if (i == nextWave)
+			{
+				nextWave = sourcesToParse.size();
+				parsedAhead = parseAhead(sourcesToParse, i, nextWave);
+			}
+
 			std::string const& path = sourcesToParse[i];
 			Source& source = m_sources[path];
-			source.ast = parser.parse(*source.charStream);
+			auto ahead = parsedAhead.find(i);
+			// The standard library sources replace the content of sources with the same name.
+			if (ahead != parsedAhead.end() && ahead->second->charStream == source.charStream)
+			{
+				ParsedAhead& result = *ahead->second;
+				// The limit on the number of errors applies to all sources together. Once it is
+				// exceeded, the parser would have stopped and not returned an AST.
+				if (m_errorReporter.appendWithinLimits(result.errors))
+				{
+					if (result.exception)
+						std::rethrow_exception(result.exception);
+					result.parser.shiftNodeIDs(maxID);
+					maxID = result.parser.maxID();
+					source.ast = result.ast;
+				}
+			}
+			else
+			{
+				Parser parser{m_errorReporter, m_evmVersion, maxID};
+				source.ast = parser.parse(*source.charStream);
+				maxID = parser.maxID();
+			}
+
 			if (!source.ast)
 				solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
 			else
@@ -405,7 +490,7 @@ bool CompilerStack::parse()
 		storeContractDefinitions();
 
 		solAssert(!m_maxAstId.has_value());
-		m_maxAstId = parser.maxID();
+		m_maxAstId = maxID;
 	}
 	catch (UnimplementedFeatureError const& _error)
 	{
@@ -438,9 +523,52 @@ void CompilerStack::importASTs(std::map<std::string, Json> const& _sources)
 	storeContractDefinitions();
 }
 
+std::map<size_t, std::unique_ptr<CompilerStack::ParsedAhead>> CompilerStack::parseAhead(
+	std::vector<std::string> const& _sourceNames,
+	size_t _begin,
+	size_t _end
+)
+{
+	std::map<size_t, std::unique_ptr<ParsedAhead>> parsedAhead;
+	if (m_parallelism <= 1)
+		return parsedAhead;
+
+	std::set<std::string> seenNames;
+	for (size_t i = _begin; i < _end; ++i)
+	{
+		std::string const& name = _sourceNames[i];
+		Source const& source = m_sources.at(name);
+		// Only the first occurrence of a source is parsed ahead. Further occurrences are parsed
+		// when they are processed.
+		if (!seenNames.insert(name).second)
+			continue;
+		parsedAhead[i] = std::make_unique<ParsedAhead>(m_evmVersion, source.charStream);
+	}
+	if (parsedAhead.size() < 2)
+		return {};
+
+	std::vector<ParsedAhead*> jobs;
+	for (auto const& item: parsedAhead)
+		jobs.push_back(item.second.get());
+	util::parallelFor(jobs.size(), m_parallelism, [&](size_t _index) {
+		ParsedAhead& job = *jobs[_index];
+		try
+		{
+			job.ast = job.parser.parse(*job.charStream);
+		}
+		catch (...)
+		{
+			// Rethrown when the source is processed, like in a sequential run.
+			job.exception = std::current_exception();
+		}
+	});
+	return parsedAhead;
+}
+
 bool CompilerStack::analyze()
 {
 	solAssert(m_stackState == ParsedAndImported, "Must call analyze only after parsing was successful.");
+	util::TimeReport::Stage stage(m_timeReport.get(), "Analysis");
 
 	if (!resolveImports())
 		return false;
@@ -455,38 +583,48 @@ bool CompilerStack::analyze()
 	{
 		bool experimentalSolidity = isExperimentalSolidity();
 
-		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
+		{
+			util::TimeReport::Stage syntaxStage("Syntax checking");
+			SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
+					noErrors = false;
+		}
 
 		m_globalContext = std::make_shared<GlobalContext>(m_evmVersion);
 		// We need to keep the same resolver during the whole process.
 		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter, experimentalSolidity);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.registerDeclarations(*source->ast))
-				return false;
+		{
+			util::TimeReport::Stage declarationStage("Declaration registration");
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.registerDeclarations(*source->ast))
+					return false;
 
-		std::map<std::string, SourceUnit const*> sourceUnitsByName;
-		for (auto& source: m_sources)
-			sourceUnitsByName[source.first] = source.second.ast.get();
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
-				return false;
+			std::map<std::string, SourceUnit const*> sourceUnitsByName;
+			for (auto& source: m_sources)
+				sourceUnitsByName[source.first] = source.second.ast.get();
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
+					return false;
 
-		resolver.warnHomonymDeclarations();
+			resolver.warnHomonymDeclarations();
+		}
 
 		{
+			util::TimeReport::Stage docStringStage("Doc string parsing");
 			DocStringTagParser docStringTagParser(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast && !docStringTagParser.parseDocStrings(*source->ast))
 					noErrors = false;
 		}
 
-		// Requires DocStringTagParser
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
-				return false;
+		{
+			util::TimeReport::Stage resolutionStage("Name and type resolution");
+			// Requires DocStringTagParser
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
+					return false;
+		}
 
 		if (experimentalSolidity)
 		{
@@ -519,41 +657,54 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 {
 	bool noErrors = _noErrorsSoFar;
 
-	DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
-	for (Source const* source: m_sourceOrder)
-		if (source->ast && !declarationTypeChecker.check(*source->ast))
-			return false;
+	{
+		util::TimeReport::Stage stage("Declaration type checking");
+		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
+		for (Source const* source: m_sourceOrder)
+			if (source->ast && !declarationTypeChecker.check(*source->ast))
+				return false;
+	}
 
-	// Requires DeclarationTypeChecker to have run
-	DocStringTagParser docStringTagParser(m_errorReporter);
-	for (Source const* source: m_sourceOrder)
-		if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
-			noErrors = false;
+	{
+		util::TimeReport::Stage stage("Doc string validation");
+		// Requires DeclarationTypeChecker to have run
+		DocStringTagParser docStringTagParser(m_errorReporter);
+		for (Source const* source: m_sourceOrder)
+			if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
+				noErrors = false;
+	}
 
-	// Next, we check inheritance, overrides, function collisions and other things at
-	// contract or function level.
-	// This also calculates whether a contract is abstract, which is needed by the
-	// type checker.
-	ContractLevelChecker contractLevelChecker(m_errorReporter);
+	{
+		util::TimeReport::Stage stage("Contract level checking");
+		// Next, we check inheritance, overrides, function collisions and other things at
+		// contract or function level.
+		// This also calculates whether a contract is abstract, which is needed by the
+		// type checker.
+		ContractLevelChecker contractLevelChecker(m_errorReporter);
 
-	for (Source const* source: m_sourceOrder)
-		if (auto sourceAst = source->ast)
-			noErrors = contractLevelChecker.check(*sourceAst);
-
-	// Now we run full type checks that go down to the expression level. This
-	// cannot be done earlier, because we need cross-contract types and information
-	// about whether a contract is abstract for the `new` expression.
-	// This populates the `type` annotation for all expressions.
-	//
-	// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
-	// which is only done one step later.
-	TypeChecker typeChecker(m_evmVersion, m_errorReporter);
-	for (Source const* source: m_sourceOrder)
-		if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
-			noErrors = false;
+		for (Source const* source: m_sourceOrder)
+			if (auto sourceAst = source->ast)
+				noErrors = contractLevelChecker.check(*sourceAst);
+	}
+
+	{
+		util::TimeReport::Stage stage("Type checking");
+		// Now we run full type checks that go down to the expression level. This
+		// cannot be done earlier, because we need cross-contract types and information
+		// about whether a contract is abstract for the `new` expression.
+		// This populates the `type` annotation for all expressions.
+		//
+		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
+		// which is only done one step later.
+		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
+		for (Source const* source: m_sourceOrder)
+			if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
+				noErrors = false;
+	}
 
 	if (noErrors)
 	{
+		util::TimeReport::Stage stage("Doc string analysis");
 		// Requires ContractLevelChecker and TypeChecker
 		DocStringAnalyser docStringAnalyser(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
@@ -563,6 +714,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 
 	if (noErrors)
 	{
+		util::TimeReport::Stage stage("Post type checking");
 		// Checks that can only be done when all types of all AST nodes are known.
 		PostTypeChecker postTypeChecker(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
@@ -575,27 +727,35 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	// Create & assign callgraphs and check for contract dependency cycles
 	if (noErrors)
 	{
+		util::TimeReport::Stage stage("Call graph construction");
 		createAndAssignCallGraphs();
 		annotateInternalFunctionIDs();
 		findAndReportCyclicContractDependencies();
 	}
 
 	if (noErrors)
+	{
+		util::TimeReport::Stage stage("Post type contract level checking");
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !PostTypeContractLevelChecker{m_errorReporter}.check(*source->ast))
 				noErrors = false;
+	}
 
 	// Check that immutable variables are never read in c'tors and assigned
 	// exactly once
 	if (noErrors)
+	{
+		util::TimeReport::Stage stage("Immutable validation");
 		for (Source const* source: m_sourceOrder)
 			if (source->ast)
 				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 						ImmutableValidator(m_errorReporter, *contract).analyze();
+	}
 
 	if (noErrors)
 	{
+		util::TimeReport::Stage stage("Control flow analysis");
 		// Control flow graph generator and analyzer. It can check for issues such as
 		// variable is used before it is assigned to.
 		CFG cfg(m_errorReporter);
@@ -616,6 +776,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 
 	if (noErrors)
 	{
+		util::TimeReport::Stage stage("Static analysis");
 		// Checks for common mistakes. Only generates warnings.
 		StaticAnalyzer staticAnalyzer(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
@@ -625,6 +786,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 
 	if (noErrors)
 	{
+		util::TimeReport::Stage stage("View and pure checking");
 		// Check for state mutability in every function.
 		std::vector<ASTPointer<ASTNode>> ast;
 		for (Source const* source: m_sourceOrder)
@@ -637,6 +799,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 
 	if (noErrors)
 	{
+		util::TimeReport::Stage stage("Model checking");
 		// Run SMTChecker
 
 		auto allSources = util::applyMap(m_sourceOrder, [](Source const* _source) { return _source->ast; });
@@ -718,45 +881,88 @@ bool CompilerStack::compile(State _stopAfter)
 	if (m_stackState >= m_stopAfter)
 		return true;
 
+	auto const reportCodegenErrors = [&](auto const& _codegen) -> bool
+	{
+		try
+		{
+			_codegen();
+		}
+		catch (Error const& _error)
+		{
+			// Since codegen has no access to the error reporter, the only way for it to
+			// report an error is to throw. In most cases it uses dedicated exceptions,
+			// but CodeGenerationError is one case where someone decided to just throw Error.
+			solAssert(_error.type() == Error::Type::CodeGenerationError);
+			m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+			return false;
+		}
+		catch (UnimplementedFeatureError const& _error)
+		{
+			reportUnimplementedFeatureError(_error);
+			return false;
+		}
+		return true;
+	};
+
 	// Only compile contracts individually which have been requested.
 	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
 
+	// IR generation reads and lazily fills caches shared by all contracts (types, annotations),
+	// so it always runs sequentially. Afterwards each contract carries all its dependencies as
+	// unoptimized Yul sub-objects, which makes optimization and EVM code generation independent
+	// between contracts. These are deferred and run in parallel if requested.
+	bool const parallelEVMFromIR = m_generateEvmBytecode && m_viaIR && m_parallelism > 1;
+	std::vector<ContractDefinition const*> deferredEVMFromIR;
+
+	m_optimizedYulCodeCache = std::make_shared<yul::OptimizedCodeCache>();
+
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
 				{
-					try
-					{
+					bool const success = reportCodegenErrors([&]() {
 						if ((m_generateEvmBytecode && m_viaIR) || m_generateIR)
 							generateIR(*contract);
 						if (m_generateEvmBytecode)
 						{
-							if (m_viaIR)
-								generateEVMFromIR(*contract);
-							else
+							if (!m_viaIR)
 							{
 								if (m_experimentalAnalysis)
 									solThrow(CompilerError, "Legacy codegen after experimental analysis is unsupported.");
 								compileContract(*contract, otherCompilers);
 							}
+							else if (parallelEVMFromIR)
+								deferredEVMFromIR.push_back(contract);
+							else
+							{
+								generateEVMFromIR(*contract);
+								reportContractSizeWarnings(*contract);
+							}
 						}
-					}
-					catch (Error const& _error)
-					{
-						// Since codegen has no access to the error reporter, the only way for it to
-						// report an error is to throw. In most cases it uses dedicated exceptions,
-						// but CodeGenerationError is one case where someone decided to just throw Error.
-						solAssert(_error.type() == Error::Type::CodeGenerationError);
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
-						return false;
-					}
-					catch (UnimplementedFeatureError const& _error)
-					{
-						reportUnimplementedFeatureError(_error);
+					});
+					if (!success)
 						return false;
-					}
 				}
+
+	if (!deferredEVMFromIR.empty())
+	{
+		// The contracts already share the threads, so each of them only gets its part for its sub-objects.
+		for (ContractDefinition const* contract: deferredEVMFromIR)
+			if (auto const& stack = m_contracts.at(contract->fullyQualifiedName()).yulIRCodegenStack)
+				stack->setConcurrency(std::max<size_t>(1, m_parallelism / deferredEVMFromIR.size()));
+		bool const success = reportCodegenErrors([&]() {
+			util::parallelFor(deferredEVMFromIR.size(), m_parallelism, [&](size_t _index) {
+				generateEVMFromIR(*deferredEVMFromIR[_index]);
+			});
+		});
+		if (!success)
+			return false;
+		for (ContractDefinition const* contract: deferredEVMFromIR)
+			reportContractSizeWarnings(*contract);
+	}
+
+	m_optimizedYulCodeCache.reset();
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
@@ -917,14 +1123,33 @@ Json const& CompilerStack::yulIRAst(std::string const& _contractName) const
 std::string const& CompilerStack::yulIROptimized(std::string const& _contractName) const
 {
 	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
-	return contract(_contractName).yulIROptimized;
+	Contract const& compiledContract = contract(_contractName);
+	return compiledContract.yulIROptimized.init([&]{
+		if (!compiledContract.yulIROptimizedStack)
+			return std::string{};
+		return compiledContract.yulIROptimizedStack->print(this);
+	});
 }
 
 Json const& CompilerStack::yulIROptimizedAst(std::string const& _contractName) const
 {
 	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
 	solUnimplementedAssert(!isExperimentalSolidity());
-	return contract(_contractName).yulIROptimizedAst;
+	Contract const& compiledContract = contract(_contractName);
+	return compiledContract.yulIROptimizedAst.init([&]{
+		if (!compiledContract.yulIROptimizedStack)
+			return Json{};
+		return compiledContract.yulIROptimizedStack->astJson();
+	});
+}
+
+Json CompilerStack::optimiserStepProfile(std::string const& _contractName) const
+{
+	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
+	Contract const& compiledContract = contract(_contractName);
+	if (!compiledContract.optimiserStepProfile)
+		return Json{};
+	return compiledContract.optimiserStepProfile->toJson();
 }
 
 evmasm::LinkerObject const& CompilerStack::object(std::string const& _contractName) const
@@ -1305,6 +1530,7 @@ void CompilerStack::assembleYul(
 	solAssert(m_stackState >= AnalysisSuccessful, "");
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	util::TimeReport::Stage stage("Assembly");
 
 	compiledContract.evmAssembly = _assembly;
 	solAssert(compiledContract.evmAssembly, "");
@@ -1330,6 +1556,11 @@ void CompilerStack::assembleYul(
 	{
 		solAssert(false, "Assembly exception for deployed bytecode");
 	}
+}
+
+void CompilerStack::reportContractSizeWarnings(ContractDefinition const& _contract)
+{
+	Contract const& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
 	// Throw a warning if EIP-170 limits are exceeded:
 	//   If contract creation returns data with length greater than 0x6000 (2^14 + 2^13) bytes,
@@ -1387,6 +1618,7 @@ void CompilerStack::compileContract(
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	util::TimeReport::Stage stage(m_timeReport.get(), "Code generation", compiledContract.contract->fullyQualifiedName());
 
 	std::shared_ptr<Compiler> compiler = std::make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
 	compiledContract.compiler = compiler;
@@ -1400,6 +1632,7 @@ void CompilerStack::compileContract(
 	_otherCompilers[compiledContract.contract] = compiler;
 
 	assembleYul(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr());
+	reportContractSizeWarnings(_contract);
 }
 
 void CompilerStack::generateIR(ContractDefinition const& _contract)
@@ -1425,64 +1658,101 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	if (!_contract.canBeDeployed())
 		return;
 
-	std::map<ContractDefinition const*, std::string_view const> otherYulSources;
-	for (auto const& pair: m_contracts)
-		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
+	util::TimeReport::Stage stage(m_timeReport.get(), "Yul IR", _contract.fullyQualifiedName());
 
-	if (m_experimentalAnalysis)
 	{
-		experimental::IRGenerator generator(
-			m_evmVersion,
-			m_eofVersion,
-			m_revertStrings,
-			sourceIndices(),
-			m_debugInfoSelection,
-			this,
-			*m_experimentalAnalysis
-		);
-		compiledContract.yulIR = generator.run(
-			_contract,
-			{}, // TODO: createCBORMetadata(compiledContract, /* _forIR */ true),
-			otherYulSources
-		);
-	}
-	else
-	{
-		IRGenerator generator(
-			m_evmVersion,
-			m_eofVersion,
-			m_revertStrings,
-			sourceIndices(),
-			m_debugInfoSelection,
-			this,
-			m_optimiserSettings
-		);
-		compiledContract.yulIR = generator.run(
-			_contract,
-			createCBORMetadata(compiledContract, /* _forIR */ true),
-			otherYulSources
-		);
+		util::TimeReport::Stage generationStage("IR generation");
+
+		std::map<ContractDefinition const*, std::string_view const> otherYulSources;
+		for (auto const& pair: m_contracts)
+			otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
+
+		if (m_experimentalAnalysis)
+		{
+			experimental::IRGenerator generator(
+				m_evmVersion,
+				m_eofVersion,
+				m_revertStrings,
+				sourceIndices(),
+				m_debugInfoSelection,
+				this,
+				*m_experimentalAnalysis
+			);
+			compiledContract.yulIR = generator.run(
+				_contract,
+				{}, // TODO: createCBORMetadata(compiledContract, /* _forIR */ true),
+				otherYulSources
+			);
+		}
+		else
+		{
+			IRGenerator generator(
+				m_evmVersion,
+				m_eofVersion,
+				m_revertStrings,
+				sourceIndices(),
+				m_debugInfoSelection,
+				this,
+				m_optimiserSettings
+			);
+			compiledContract.yulIR = generator.run(
+				_contract,
+				createCBORMetadata(compiledContract, /* _forIR */ true),
+				otherYulSources
+			);
+		}
 	}
 
-	yul::YulStack stack(
+	auto stack = std::make_shared<yul::YulStack>(
 		m_evmVersion,
 		m_eofVersion,
 		yul::YulStack::Language::StrictAssembly,
 		m_optimiserSettings,
 		m_debugInfoSelection
 	);
-	bool yulAnalysisSuccessful = stack.parseAndAnalyze("", compiledContract.yulIR);
-	solAssert(
-		yulAnalysisSuccessful,
-		compiledContract.yulIR + "\n\n"
-		"Invalid IR generated:\n" +
-		langutil::SourceReferenceFormatter::formatErrorInformation(stack.errors(), stack) + "\n"
-	);
+	stack->setOptimizedCodeCache(m_optimizedYulCodeCache);
+	// Contracts are optimized one after the other, so all threads are available to each of them.
+	stack->setConcurrency(m_parallelism);
+	{
+		util::TimeReport::Stage analysisStage("Yul analysis");
+		bool yulAnalysisSuccessful = stack->parseAndAnalyze("", compiledContract.yulIR);
+		solAssert(
+			yulAnalysisSuccessful,
+			compiledContract.yulIR + "\n\n"
+			"Invalid IR generated:\n" +
+			langutil::SourceReferenceFormatter::formatErrorInformation(stack->errors(), *stack) + "\n"
+		);
+	}
 
-	compiledContract.yulIRAst = stack.astJson();
-	stack.optimize();
-	compiledContract.yulIROptimized = stack.print(this);
-	compiledContract.yulIROptimizedAst = stack.astJson();
+	compiledContract.yulIRAst = stack->astJson();
+	std::shared_ptr<yul::OptimiserStepProfile> profile;
+	if (m_optimiserStepProfile)
+		profile = std::make_shared<yul::OptimiserStepProfile>();
+	stack->setOptimiserStepProfile(profile);
+	stack->optimize();
+	stack->setOptimiserStepProfile(nullptr);
+	compiledContract.optimiserStepProfile = std::move(profile);
+	stack->setOptimizedCodeCache(nullptr);
+	// The optimized IR and its AST are only produced on request.
+	compiledContract.yulIROptimizedStack = stack;
+	if (m_debugInfoSelection.none())
+		// The printed code would not contain any debug data, so parsing it again would not
+		// change anything that matters to code generation.
+		compiledContract.yulIRCodegenStack = std::move(stack);
+	else
+	{
+		// The source mappings are defined by the comments in the printed code, so it is parsed
+		// again in generateEVMFromIR(). The stack is created here, since code generation may run
+		// on worker threads, which must not create YulStacks.
+		compiledContract.yulIRCodegenStack = std::make_shared<yul::YulStack>(
+			m_evmVersion,
+			m_eofVersion,
+			yul::YulStack::Language::StrictAssembly,
+			m_optimiserSettings,
+			m_debugInfoSelection
+		);
+		compiledContract.yulIRCodegenStack->setConcurrency(m_parallelism);
+	}
 }
 
 void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
@@ -1493,26 +1763,26 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
 	if (!compiledContract.object.bytecode.empty())
 		return;
+	solAssert(compiledContract.yulIROptimizedStack && compiledContract.yulIRCodegenStack, "");
 
-	// Re-parse the Yul IR in EVM dialect
-	yul::YulStack stack(
-		m_evmVersion,
-		m_eofVersion,
-		yul::YulStack::Language::StrictAssembly,
-		m_optimiserSettings,
-		m_debugInfoSelection
-	);
-	bool analysisSuccessful = stack.parseAndAnalyze("", compiledContract.yulIROptimized);
-	solAssert(analysisSuccessful);
-
-	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
+	util::TimeReport::Stage stage(m_timeReport.get(), "EVM code generation", _contract.fullyQualifiedName());
+	yul::YulStack& stack = *compiledContract.yulIRCodegenStack;
+	if (compiledContract.yulIRCodegenStack != compiledContract.yulIROptimizedStack)
+	{
+		// Re-parse the Yul IR in EVM dialect
+		std::string const& yulIROptimized = compiledContract.yulIROptimized.init([&]{
+			return compiledContract.yulIROptimizedStack->print(this);
+		});
+		bool analysisSuccessful = stack.parseAndAnalyze("", yulIROptimized);
+		solAssert(analysisSuccessful);
+	}
 
 	std::string deployedName = IRNames::deployedObject(_contract);
 	solAssert(!deployedName.empty(), "");
 	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
+	compiledContract.yulIRCodegenStack.reset();
 	assembleYul(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
 }
 
@@ -1628,6 +1898,13 @@ std::string CompilerStack::createMetadata(Contract const& _contract, bool _forIR
 			details["yulDetails"] = Json::object();
 			details["yulDetails"]["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
 			details["yulDetails"]["optimizerSteps"] = m_optimiserSettings.yulOptimiserSteps + ":" + m_optimiserSettings.yulOptimiserCleanupSteps;
+			// The search is deterministic, so the budget suffices to reproduce the chosen sequences.
+			if (m_optimiserSettings.yulOptimiserSearchBudget > 0)
+				details["yulDetails"]["searchBudget"] = Json::number_unsigned_t(m_optimiserSettings.yulOptimiserSearchBudget);
+			if (m_optimiserSettings.stackLayoutSearchEffort > 0)
+				details["yulDetails"]["stackLayoutSearchEffort"] = Json::number_unsigned_t(m_optimiserSettings.stackLayoutSearchEffort);
+			if (m_optimiserSettings.yulOptimiserInlineBudget.has_value())
+				details["yulDetails"]["inlineBudget"] = Json::number_unsigned_t(*m_optimiserSettings.yulOptimiserInlineBudget);
 		}
 		else if (OptimiserSuite::isEmptyOptimizerSequence(m_optimiserSettings.yulOptimiserSteps + ":" + m_optimiserSettings.yulOptimiserCleanupSteps))
 		{
@@ -1823,7 +2100,7 @@ Json CompilerStack::gasEstimates(std::string const& _contractName) const
 		return Json();
 
 	using Gas = GasEstimator::GasConsumption;
-	GasEstimator gasEstimator(m_evmVersion);
+	GasEstimator gasEstimator(m_evmVersion, m_gasEstimationEngine);
 	Json output = Json::object();
 
 	if (evmasm::AssemblyItems const* items = assemblyItems(_contractName))
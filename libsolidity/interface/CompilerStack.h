@@ -30,6 +30,7 @@
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/interface/DebugSettings.h>
+#include <libsolidity/interface/GasEstimationSettings.h>
 
 #include <libsolidity/formal/ModelCheckerSettings.h>
 
@@ -44,10 +45,13 @@
 #include <libevmasm/AbstractAssemblyStack.h>
 #include <libevmasm/LinkerObject.h>
 
+#include <libyul/YulString.h>
+
 #include <libsolutil/Common.h>
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/TimeReport.h>
 
 #include <functional>
 #include <memory>
@@ -62,6 +66,13 @@ class CharStream;
 }
 
 
+namespace solidity::yul
+{
+class OptimizedCodeCache;
+class OptimiserStepProfile;
+class YulStack;
+}
+
 namespace solidity::evmasm
 {
 class Assembly;
@@ -180,6 +191,14 @@ public:
 	/// Set model checker settings.
 	void setModelCheckerSettings(ModelCheckerSettings _settings);
 
+	/// Sets the maximum number of threads used to parse sources, to run function-local Yul
+	/// optimiser steps on the functions of a contract and to generate code for independent
+	/// contracts. Only EVM code generation via the IR runs in parallel. The default
+	/// of one keeps compilation on the calling thread. Neither the diagnostics, nor the ASTs,
+	/// nor the generated code depend on this setting.
+	/// Must be set before compiling.
+	void setParallelism(size_t _parallelism);
+
 	/// Sets the requested contract names by source.
 	/// If empty, no filtering is performed and every contract
 	/// found in the supplied sources is compiled.
@@ -189,6 +208,20 @@ public:
 		m_requestedContractNames = _contractNames;
 	}
 
+	/// Records the wall time and peak memory usage of the compilation stages, see timeReport().
+	/// Must be set before parsing.
+	void enableTimeReport(bool _enable = true);
+
+	/// @returns the stages recorded since the last reset, or null if the time report is disabled.
+	util::TimeReport const* timeReport() const { return m_timeReport.get(); }
+
+	/// Records every Yul optimiser step run on the IR of each contract, see optimiserStepProfile().
+	/// Must be set before compiling.
+	void enableOptimiserStepProfile(bool _enable = true);
+
+	/// Selects the algorithm gasEstimates() uses to compute upper bounds on the gas usage.
+	void setGasEstimationEngine(GasEstimationEngine _engine) { m_gasEstimationEngine = _engine; }
+
 	/// Enable EVM Bytecode generation. This is enabled by default.
 	void enableEvmBytecodeGeneration(bool _enable = true) { m_generateEvmBytecode = _enable; }
 
@@ -284,6 +317,12 @@ public:
 	/// @returns the optimized IR representation of a contract AST in JSON format.
 	Json const& yulIROptimizedAst(std::string const& _contractName) const;
 
+	/// @returns the Yul optimiser steps run on the IR of a contract in the format of
+	/// yul::OptimiserStepProfile::toJson(), or null if the profile is disabled or no IR was
+	/// optimized. Objects whose optimized code was taken from the cache of identical objects
+	/// are not part of the profile.
+	Json optimiserStepProfile(std::string const& _contractName) const;
+
 	/// @returns the assembled object for a contract.
 	virtual evmasm::LinkerObject const& object(std::string const& _contractName) const override;
 
@@ -378,6 +417,8 @@ private:
 		std::string const& ipfsUrl() const;
 	};
 
+	struct ParsedAhead;
+
 	/// The state per contract. Filled gradually during compilation.
 	struct Contract
 	{
@@ -388,9 +429,15 @@ private:
 		evmasm::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Yul IR code.
-		std::string yulIROptimized; ///< Optimized Yul IR code.
+		/// Optimized and analyzed Yul IR. The optimized IR outputs are generated from it on request.
+		std::shared_ptr<yul::YulStack> yulIROptimizedStack;
+		/// Stack that EVM code generation assembles. Either the optimized stack or, if the optimized
+		/// IR has to be printed and parsed again for its debug data, an empty one. Released afterwards.
+		std::shared_ptr<yul::YulStack> yulIRCodegenStack;
+		util::LazyInit<std::string const> yulIROptimized; ///< Optimized Yul IR code.
 		Json yulIRAst; ///< JSON AST of Yul IR code.
-		Json yulIROptimizedAst; ///< JSON AST of optimized Yul IR code.
+		util::LazyInit<Json const> yulIROptimizedAst; ///< JSON AST of optimized Yul IR code.
+		std::shared_ptr<yul::OptimiserStepProfile const> optimiserStepProfile;
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
 		util::LazyInit<Json const> abi;
 		util::LazyInit<Json const> storageLayout;
@@ -440,6 +487,11 @@ private:
 		std::shared_ptr<evmasm::Assembly> _runtimeAssembly
 	);
 
+	/// Warns if the assembled code of the contract exceeds the limits of the target EVM version.
+	/// Kept separate from assembleYul because it accesses the error reporter, which must not
+	/// happen during parallel code generation.
+	void reportContractSizeWarnings(ContractDefinition const& _contract);
+
 	/// Compile a single contract.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
@@ -454,6 +506,8 @@ private:
 
 	/// Generate EVM representation for a single contract.
 	/// Depends on output generated by generateIR.
+	/// Does not modify any state shared between contracts and can therefore run concurrently
+	/// for different contracts.
 	void generateEVMFromIR(ContractDefinition const& _contract);
 
 	/// Links all the known library addresses in the available objects. Any unknown
@@ -505,6 +559,18 @@ private:
 
 	void reportUnimplementedFeatureError(langutil::UnimplementedFeatureError const& _error);
 
+	/// Parses the sources in @a _sourceNames from index @a _begin up to @a _end in parallel,
+	/// unless the parallelism is one or there are fewer than two of them that need parsing.
+	/// The node IDs of the results start at one and have to be shifted when they are used.
+	std::map<size_t, std::unique_ptr<ParsedAhead>> parseAhead(
+		std::vector<std::string> const& _sourceNames,
+		size_t _begin,
+		size_t _end
+	);
+
+	/// Keeps the YulStrings of inline assembly and of the generated IR valid. Declared first,
+	/// so that it is released last.
+	yul::YulStringRepository::UsageGuard m_yulStringGuard;
 	ReadCallback::Callback m_readFile;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
@@ -516,15 +582,22 @@ private:
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateEvmBytecode = true;
 	bool m_generateIR = false;
+	size_t m_parallelism = 1;
 	std::map<std::string, util::h160> m_libraries;
 	ImportRemapper m_importRemapper;
 	std::map<std::string const, Source> m_sources;
 	std::optional<int64_t> m_maxAstId;
+	std::unique_ptr<util::TimeReport> m_timeReport;
+	bool m_optimiserStepProfile = false;
+	GasEstimationEngine m_gasEstimationEngine = GasEstimationEngine::Path;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
 	std::map<util::h256, std::string> m_smtlib2Responses;
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
+	/// Optimized code of the Yul objects of the current compilation. Contracts created by other
+	/// contracts are embedded into each of them, but need to be optimized only once.
+	std::shared_ptr<yul::OptimizedCodeCache> m_optimizedYulCodeCache;
 
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
@@ -0,0 +1,55 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Settings for the estimation of the gas usage of contracts.
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+
+namespace solidity::frontend
+{
+
+enum class GasEstimationEngine
+{
+	Path, // follows the paths through the code one by one (evmasm::PathGasMeter)
+	Dataflow // analyses the control flow graph (evmasm::DataflowGasMeter)
+};
+
+inline std::string gasEstimationEngineToString(GasEstimationEngine _engine)
+{
+	switch (_engine)
+	{
+	case GasEstimationEngine::Path: return "path";
+	case GasEstimationEngine::Dataflow: return "dataflow";
+	}
+	// Cannot reach this.
+	return "INVALID";
+}
+
+inline std::optional<GasEstimationEngine> gasEstimationEngineFromString(std::string const& _str)
+{
+	for (auto i: {GasEstimationEngine::Path, GasEstimationEngine::Dataflow})
+		if (gasEstimationEngineToString(i) == _str)
+			return i;
+	return std::nullopt;
+}
+
+}
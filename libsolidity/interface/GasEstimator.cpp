@@ -28,6 +28,7 @@
 #include <libsolidity/codegen/CompilerUtils.h>
 
 #include <libevmasm/ControlFlowGraph.h>
+#include <libevmasm/DataflowGasMeter.h>
 #include <libevmasm/KnownState.h>
 #include <libevmasm/PathGasMeter.h>
 #include <libsolutil/FunctionSelector.h>
@@ -78,7 +79,7 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 		);
 	}
 
-	return PathGasMeter::estimateMax(_items, m_evmVersion, 0, state);
+	return estimateMax(_items, 0, state);
 }
 
 GasEstimator::GasConsumption GasEstimator::functionalEstimation(
@@ -100,7 +101,23 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 	if (parametersSize > 0)
 		state->feedItem(swapInstruction(parametersSize));
 
-	return PathGasMeter::estimateMax(_items, m_evmVersion, _offset, state);
+	return estimateMax(_items, _offset, state);
+}
+
+GasEstimator::GasConsumption GasEstimator::estimateMax(
+	AssemblyItems const& _items,
+	size_t _offset,
+	std::shared_ptr<KnownState> const& _state
+) const
+{
+	switch (m_engine)
+	{
+	case GasEstimationEngine::Path:
+		return PathGasMeter::estimateMax(_items, m_evmVersion, _offset, _state);
+	case GasEstimationEngine::Dataflow:
+		return DataflowGasMeter::estimateMax(_items, m_evmVersion, _offset, _state);
+	}
+	util::unreachable();
 }
 
 std::set<ASTNode const*> GasEstimator::finestNodesAtLocation(
@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include <libsolidity/interface/GasEstimationSettings.h>
+
 #include <liblangutil/EVMVersion.h>
 
 #include <libevmasm/Assembly.h>
@@ -30,8 +32,14 @@
 
 #include <array>
 #include <map>
+#include <memory>
 #include <vector>
 
+namespace solidity::evmasm
+{
+class KnownState;
+}
+
 namespace solidity::frontend
 {
 
@@ -46,7 +54,13 @@ public:
 	using ASTGasConsumptionSelfAccumulated =
 		std::map<ASTNode const*, std::array<GasConsumption, 2>>;
 
-	explicit GasEstimator(langutil::EVMVersion _evmVersion): m_evmVersion(_evmVersion) {}
+	explicit GasEstimator(
+		langutil::EVMVersion _evmVersion,
+		GasEstimationEngine _engine = GasEstimationEngine::Path
+	):
+		m_evmVersion(_evmVersion),
+		m_engine(_engine)
+	{}
 
 	/// @returns the estimated gas consumption by the (public or external) function with the
 	/// given signature. If no signature is given, estimates the maximum gas usage.
@@ -67,7 +81,15 @@ public:
 private:
 	/// @returns the set of AST nodes which are the finest nodes at their location.
 	static std::set<ASTNode const*> finestNodesAtLocation(std::vector<ASTNode const*> const& _roots);
+	/// @returns an upper bound on the gas usage from @a _offset on, using the selected engine.
+	GasConsumption estimateMax(
+		evmasm::AssemblyItems const& _items,
+		size_t _offset,
+		std::shared_ptr<evmasm::KnownState> const& _state
+	) const;
+
 	langutil::EVMVersion m_evmVersion;
+	GasEstimationEngine m_engine;
 };
 
 }
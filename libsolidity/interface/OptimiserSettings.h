@@ -26,6 +26,7 @@
 #include <liblangutil/Exceptions.h>
 
 #include <cstddef>
+#include <optional>
 #include <string>
 
 namespace solidity::frontend
@@ -125,6 +126,9 @@ struct OptimiserSettings
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
+			yulOptimiserSearchBudget == _other.yulOptimiserSearchBudget &&
+			stackLayoutSearchEffort == _other.stackLayoutSearchEffort &&
+			yulOptimiserInlineBudget == _other.yulOptimiserInlineBudget &&
 			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
 	}
 
@@ -164,6 +168,15 @@ struct OptimiserSettings
 	/// is left empty, there will still be hard-coded optimisation steps that will run regardless.
 	/// Set @a runYulOptimiser to false if you want no optimisations.
 	std::string yulOptimiserCleanupSteps = DefaultYulOptimiserCleanupSteps;
+	/// Number of variations of yulOptimiserSteps the Yul optimiser tries for every object in
+	/// search of cheaper code. Zero means that yulOptimiserSteps is used as it is.
+	size_t yulOptimiserSearchBudget = 0;
+	/// Maximum number of rounds of local search spent on improving the stack layouts at conditional
+	/// jumps when generating EVM code from optimized Yul. Zero only uses a fast heuristic.
+	size_t stackLayoutSearchEffort = 0;
+	/// Code size by which all runs of the FullInliner on an object together may grow the code
+	/// by copying function bodies. The value nullopt represents no limit.
+	std::optional<size_t> yulOptimiserInlineBudget;
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
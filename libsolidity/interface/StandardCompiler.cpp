@@ -39,6 +39,7 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
 
 #include <boost/algorithm/string/predicate.hpp>
 
@@ -425,7 +426,7 @@ std::optional<Json> checkAuxiliaryInputKeys(Json const& _input)
 
 std::optional<Json> checkSettingsKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static std::set<std::string> keys{"cache", "debug", "evmVersion", "gasEstimation", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "parallelism", "remappings", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
@@ -619,12 +620,30 @@ std::variant<OptimiserSettings, Json> parseOptimizerSettings(Json const& _jsonIn
 				return {std::move(settings)};
 			}
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps", "searchBudget", "stackLayoutSearchEffort", "inlineBudget"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
 			if (auto error = checkOptimizerDetailSteps(details["yulDetails"], "optimizerSteps", settings.yulOptimiserSteps, settings.yulOptimiserCleanupSteps, settings.runYulOptimiser))
 				return *error;
+			if (details["yulDetails"].contains("searchBudget"))
+			{
+				if (!details["yulDetails"]["searchBudget"].is_number_unsigned())
+					return formatFatalError(Error::Type::JSONError, "The \"searchBudget\" setting must be an unsigned number.");
+				settings.yulOptimiserSearchBudget = details["yulDetails"]["searchBudget"].get<size_t>();
+			}
+			if (details["yulDetails"].contains("stackLayoutSearchEffort"))
+			{
+				if (!details["yulDetails"]["stackLayoutSearchEffort"].is_number_unsigned())
+					return formatFatalError(Error::Type::JSONError, "The \"stackLayoutSearchEffort\" setting must be an unsigned number.");
+				settings.stackLayoutSearchEffort = details["yulDetails"]["stackLayoutSearchEffort"].get<size_t>();
+			}
+			if (details["yulDetails"].contains("inlineBudget"))
+			{
+				if (!details["yulDetails"]["inlineBudget"].is_number_unsigned())
+					return formatFatalError(Error::Type::JSONError, "The \"inlineBudget\" setting must be an unsigned number.");
+				settings.yulOptimiserInlineBudget = details["yulDetails"]["inlineBudget"].get<size_t>();
+			}
 		}
 	}
 	return {std::move(settings)};
@@ -816,6 +835,36 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.viaIR = settings["viaIR"].get<bool>();
 	}
 
+	if (settings.contains("parallelism"))
+	{
+		if (!settings["parallelism"].is_number_unsigned() || settings["parallelism"].get<size_t>() == 0)
+			return formatFatalError(Error::Type::JSONError, "\"settings.parallelism\" must be a positive integer.");
+		ret.parallelism = settings["parallelism"].get<size_t>();
+	}
+
+	if (settings.contains("cache"))
+	{
+		if (!settings["cache"].is_boolean())
+			return formatFatalError(Error::Type::JSONError, "\"settings.cache\" must be a Boolean.");
+		ret.useCache = settings["cache"].get<bool>();
+	}
+
+	if (settings.contains("gasEstimation"))
+	{
+		if (auto result = checkKeys(settings["gasEstimation"], {"engine"}, "settings.gasEstimation"))
+			return *result;
+
+		if (settings["gasEstimation"].contains("engine"))
+		{
+			if (!settings["gasEstimation"]["engine"].is_string())
+				return formatFatalError(Error::Type::JSONError, "settings.gasEstimation.engine must be a string.");
+			std::optional<GasEstimationEngine> engine = gasEstimationEngineFromString(settings["gasEstimation"]["engine"].get<std::string>());
+			if (!engine)
+				return formatFatalError(Error::Type::JSONError, "Invalid value for settings.gasEstimation.engine.");
+			ret.gasEstimationEngine = *engine;
+		}
+	}
+
 	if (settings.contains("evmVersion"))
 	{
 		if (!settings["evmVersion"].is_string())
@@ -844,7 +893,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 
 	if (settings.contains("debug"))
 	{
-		if (auto result = checkKeys(settings["debug"], {"revertStrings", "debugInfo"}, "settings.debug"))
+		if (auto result = checkKeys(settings["debug"], {"revertStrings", "debugInfo", "timeReport", "yulOptimizerProfile"}, "settings.debug"))
 			return *result;
 
 		if (settings["debug"].contains("revertStrings"))
@@ -886,6 +935,20 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 
 			ret.debugInfoSelection = debugInfoSelection.value();
 		}
+
+		if (settings["debug"].contains("timeReport"))
+		{
+			if (!settings["debug"]["timeReport"].is_boolean())
+				return formatFatalError(Error::Type::JSONError, "settings.debug.timeReport must be a Boolean.");
+			ret.timeReport = settings["debug"]["timeReport"].get<bool>();
+		}
+
+		if (settings["debug"].contains("yulOptimizerProfile"))
+		{
+			if (!settings["debug"]["yulOptimizerProfile"].is_boolean())
+				return formatFatalError(Error::Type::JSONError, "settings.debug.yulOptimizerProfile must be a Boolean.");
+			ret.yulOptimizerProfile = settings["debug"]["yulOptimizerProfile"].get<bool>();
+		}
 	}
 
 	if (settings.contains("remappings") && !settings["remappings"].is_array())
@@ -1306,10 +1369,14 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
+	compilerStack.enableTimeReport(_inputsAndSettings.timeReport);
+	compilerStack.enableOptimiserStepProfile(_inputsAndSettings.yulOptimizerProfile);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
 	compilerStack.setRemappings(std::move(_inputsAndSettings.remappings));
 	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
 	compilerStack.setRevertStringBehaviour(_inputsAndSettings.revertStrings);
+	compilerStack.setGasEstimationEngine(_inputsAndSettings.gasEstimationEngine);
 	if (_inputsAndSettings.debugInfoSelection.has_value())
 		compilerStack.selectDebugInfo(_inputsAndSettings.debugInfoSelection.value());
 	compilerStack.setLibraries(_inputsAndSettings.libraries);
@@ -1325,6 +1392,19 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	Json errors = std::move(_inputsAndSettings.errors);
 
 	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
+	bool const useCache =
+		m_cache.has_value() &&
+		_inputsAndSettings.useCache &&
+		_inputsAndSettings.language == "Solidity" &&
+		binariesRequested &&
+		// Cached contracts would be missing from the profile.
+		!_inputsAndSettings.yulOptimizerProfile;
+	// Cache keys of the requested contracts and the outputs of those found in the cache,
+	// both by fully qualified contract name.
+	std::map<std::string, util::h256> cacheKeys;
+	std::map<std::string, Json> cachedOutputs;
+	size_t errorCountBeforeCodegen = 0;
+	bool allOutputsCached = false;
 
 	try
 	{
@@ -1345,7 +1425,49 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 		}
 		else
 		{
-			if (binariesRequested)
+			if (useCache)
+			{
+				if (compilerStack.parseAndAnalyze() && !compilerStack.isExperimentalSolidity())
+				{
+					auto requestedContracts = requestedContractNames(_inputsAndSettings.outputSelection);
+					auto isRequested = [&](std::string const& _file, std::string const& _name) {
+						for (std::string const& key: {std::string{}, _file})
+							if (requestedContracts.count(key))
+								if (requestedContracts.at(key).count(_name) || requestedContracts.at(key).count(""))
+									return true;
+						return false;
+					};
+
+					// Code generation only runs for the requested contracts that are not cached.
+					std::map<std::string, std::set<std::string>> uncachedContracts;
+					for (std::string const& contractName: compilerStack.contractNames())
+					{
+						size_t colon = contractName.rfind(':');
+						solAssert(colon != std::string::npos);
+						std::string file = contractName.substr(0, colon);
+						std::string name = contractName.substr(colon + 1);
+						if (!isRequested(file, name))
+							continue;
+
+						util::h256 key = contractCacheKey(compilerStack, contractName, _inputsAndSettings);
+						cacheKeys[contractName] = key;
+						if (std::optional<Json> cachedOutput = m_cache->load(key))
+							cachedOutputs[contractName] = std::move(*cachedOutput);
+						else
+							uncachedContracts[file].insert(name);
+					}
+					errorCountBeforeCodegen = compilerStack.errors().size();
+					allOutputsCached = uncachedContracts.empty();
+					if (!allOutputsCached)
+					{
+						compilerStack.setRequestedContractNames(uncachedContracts);
+						compilerStack.compile();
+					}
+				}
+				else if (compilerStack.state() >= CompilerStack::State::AnalysisSuccessful)
+					compilerStack.compile();
+			}
+			else if (binariesRequested)
 				compilerStack.compile();
 			else
 				compilerStack.parseAndAnalyze(_inputsAndSettings.stopAfter);
@@ -1417,7 +1539,16 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 
 	bool parsingSuccess = compilerStack.state() >= CompilerStack::State::Parsed;
 	bool analysisSuccess = compilerStack.state() >= CompilerStack::State::AnalysisSuccessful;
-	bool compilationSuccess = compilerStack.state() == CompilerStack::State::CompilationSuccessful;
+	// If all outputs were taken from the cache, code generation did not run and the CompilerStack
+	// stays in the analysis state, so its code generation artifacts must not be accessed.
+	bool codegenSuccess = compilerStack.state() == CompilerStack::State::CompilationSuccessful;
+	bool compilationSuccess = codegenSuccess || (allOutputsCached && analysisSuccess);
+	// Outputs are only stored if code generation did not report anything, since these diagnostics
+	// would be missing when the outputs are later taken from the cache.
+	bool const storeInCache =
+		useCache &&
+		compilationSuccess &&
+		compilerStack.errors().size() == errorCountBeforeCodegen;
 
 	// If analysis fails, the artifacts inside CompilerStack are potentially incomplete and must not be returned.
 	// Note that not completing analysis due to stopAfter does not count as a failure. It's neither failure nor success.
@@ -1459,6 +1590,18 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 		std::string file = contractName.substr(0, colon);
 		std::string name = contractName.substr(colon + 1);
 
+		if (cachedOutputs.count(contractName))
+		{
+			Json const& cachedOutput = cachedOutputs.at(contractName);
+			if (!cachedOutput.empty())
+			{
+				if (!contractsOutput.contains(file))
+					contractsOutput[file] = Json::object();
+				contractsOutput[file][name] = cachedOutput;
+			}
+			continue;
+		}
+
 		// ABI, storage layout, documentation and metadata
 		Json contractData;
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
@@ -1473,27 +1616,27 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 			contractData["devdoc"] = compilerStack.natspecDev(contractName);
 
 		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
+		if (codegenSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
 			contractData["ir"] = compilerStack.yulIR(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irAst", wildcardMatchesExperimental))
+		if (codegenSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irAst", wildcardMatchesExperimental))
 			contractData["irAst"] = compilerStack.yulIRAst(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
+		if (codegenSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
 			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimizedAst", wildcardMatchesExperimental))
+		if (codegenSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimizedAst", wildcardMatchesExperimental))
 			contractData["irOptimizedAst"] = compilerStack.yulIROptimizedAst(contractName);
 
 		// EVM
 		Json evmData;
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
+		if (codegenSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
 			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
+		if (codegenSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
 			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
 			evmData["methodIdentifiers"] = compilerStack.interfaceSymbols(contractName)["methods"];
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
+		if (codegenSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
 			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
 
-		if (compilationSuccess && isArtifactRequested(
+		if (codegenSuccess && isArtifactRequested(
 			_inputsAndSettings.outputSelection,
 			file,
 			name,
@@ -1515,7 +1658,7 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 				); }
 			);
 
-		if (compilationSuccess && isArtifactRequested(
+		if (codegenSuccess && isArtifactRequested(
 			_inputsAndSettings.outputSelection,
 			file,
 			name,
@@ -1540,6 +1683,9 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 		if (!evmData.empty())
 			contractData["evm"] = evmData;
 
+		if (storeInCache && cacheKeys.count(contractName))
+			m_cache->store(cacheKeys.at(contractName), contractData);
+
 		if (!contractData.empty())
 		{
 			if (!contractsOutput.contains(file))
@@ -1550,9 +1696,58 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	if (!contractsOutput.empty())
 		output["contracts"] = contractsOutput;
 
+	if (_inputsAndSettings.yulOptimizerProfile && codegenSuccess)
+		for (std::string const& contractName: compilerStack.contractNames())
+		{
+			Json profile = compilerStack.optimiserStepProfile(contractName);
+			if (profile.is_null())
+				continue;
+			size_t colon = contractName.rfind(':');
+			solAssert(colon != std::string::npos, "");
+			output["yulOptimizerProfile"][contractName.substr(0, colon)][contractName.substr(colon + 1)] = std::move(profile);
+		}
+
+	if (compilerStack.timeReport())
+		output["timeReport"] = compilerStack.timeReport()->chromeTrace();
+
 	return output;
 }
 
+util::h256 StandardCompiler::contractCacheKey(
+	CompilerStack const& _compilerStack,
+	std::string const& _contractName,
+	InputsAndSettings const& _inputsAndSettings
+)
+{
+	std::string const& metadata = _compilerStack.metadata(_contractName);
+
+	Json key;
+	key["version"] = VersionString;
+	key["metadata"] = metadata;
+	key["outputSelection"] = _inputsAndSettings.outputSelection;
+	key["metadataFormat"] = static_cast<int>(_inputsAndSettings.metadataFormat);
+	key["metadataHash"] = static_cast<int>(_inputsAndSettings.metadataHash);
+	key["eofVersion"] = _inputsAndSettings.eofVersion.has_value() ? int(*_inputsAndSettings.eofVersion) : -1;
+	if (_inputsAndSettings.debugInfoSelection.has_value())
+		key["debugInfo"] = util::toString(*_inputsAndSettings.debugInfoSelection);
+	key["gasEstimationEngine"] = gasEstimationEngineToString(_inputsAndSettings.gasEstimationEngine);
+
+	// Source indices appear in source mappings and depend on the names of all sources.
+	key["sourceNames"] = Json::array();
+	for (std::string const& sourceName: _compilerStack.sourceNames())
+		key["sourceNames"].emplace_back(sourceName);
+
+	// AST IDs are assigned in source order and also depend on the preceding sources. Given
+	// the content of a source, the ID of its source unit determines all IDs within it.
+	Json metadataJson;
+	bool metadataParsed = util::jsonParseStrict(metadata, metadataJson);
+	solAssert(metadataParsed);
+	for (auto const& [sourceName, _]: metadataJson["sources"].items())
+		key["sourceUnitIDs"][sourceName] = _compilerStack.ast(sourceName).id();
+
+	return util::keccak256(util::jsonCompactPrint(key));
+}
+
 
 Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 {
@@ -1597,6 +1792,15 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		));
 		return output;
 	}
+	if (_inputsAndSettings.timeReport)
+	{
+		output["errors"].emplace_back(formatError(
+			Error::Type::JSONError,
+			"general",
+			"Field \"settings.debug.timeReport\" cannot be used for Yul."
+		));
+		return output;
+	}
 
 	YulStack stack(
 		_inputsAndSettings.evmVersion,
@@ -1651,7 +1855,13 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		sourceResult["ast"] = stack.astJson();
 		output["sources"][sourceName] = sourceResult;
 	}
+	std::shared_ptr<OptimiserStepProfile> profile;
+	if (_inputsAndSettings.yulOptimizerProfile)
+		profile = std::make_shared<OptimiserStepProfile>();
+	stack.setOptimiserStepProfile(profile);
 	stack.optimize();
+	if (profile)
+		output["yulOptimizerProfile"][sourceName][contractName] = profile->toJson();
 
 	MachineAssemblyObject object;
 	MachineAssemblyObject deployedObject;
@@ -1700,7 +1910,9 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json StandardCompiler::compile(Json const& _input) noexcept
 {
-	YulStringRepository::reset();
+	// Other compilations running concurrently in this process keep the strings they use alive.
+	YulStringRepository::resetIfUnused();
+	YulStringRepository::UsageGuard yulStringGuard;
 
 	try
 	{
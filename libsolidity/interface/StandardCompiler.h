@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolutil/JSON.h>
 
@@ -56,6 +57,10 @@ public:
 	{
 	}
 
+	/// Enables caching the outputs of individual contracts in @a _directory across compilations.
+	/// Inputs can bypass the cache by setting "settings.cache" to false.
+	void setCacheDirectory(boost::filesystem::path _directory) { m_cache.emplace(std::move(_directory)); }
+
 	/// Sets all input parameters according to @a _input which conforms to the standardized input
 	/// format, performs compilation and returns a standardized output.
 	Json compile(Json const& _input) noexcept;
@@ -80,6 +85,7 @@ private:
 		std::optional<uint8_t> eofVersion;
 		std::vector<ImportRemapper::Remapping> remappings;
 		RevertStrings revertStrings = RevertStrings::Default;
+		GasEstimationEngine gasEstimationEngine = GasEstimationEngine::Path;
 		OptimiserSettings optimiserSettings = OptimiserSettings::minimal();
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
 		std::map<std::string, util::h160> libraries;
@@ -89,6 +95,10 @@ private:
 		Json outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		size_t parallelism = 1;
+		bool useCache = true;
+		bool timeReport = false;
+		bool yulOptimizerProfile = false;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
@@ -100,7 +110,18 @@ private:
 	Json compileSolidity(InputsAndSettings _inputsAndSettings);
 	Json compileYul(InputsAndSettings _inputsAndSettings);
 
+	/// @returns the key under which the output of @a _contractName is cached. Covers everything
+	/// the output depends on: the compiler version, the metadata of the contract (which includes
+	/// the hashes of all sources it depends on and the relevant settings), the output selection
+	/// and the source indices and AST IDs that appear in the output.
+	static util::h256 contractCacheKey(
+		CompilerStack const& _compilerStack,
+		std::string const& _contractName,
+		InputsAndSettings const& _inputsAndSettings
+	);
+
 	ReadCallback::Callback m_readFile;
+	std::optional<CompilationCache> m_cache;
 
 	util::JsonFormat m_jsonPrintingFormat;
 };
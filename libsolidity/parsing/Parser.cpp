@@ -76,7 +76,10 @@ public:
 		solAssert(m_location.sourceName, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return std::make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		auto node = std::make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		if (m_parser.m_shiftableNodeIDs)
+			m_parser.m_createdNodes.push_back(node);
+		return node;
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -86,6 +89,16 @@ private:
 	SourceLocation m_location;
 };
 
+void Parser::shiftNodeIDs(int64_t _offset)
+{
+	solAssert(_offset >= 0);
+	solAssert(m_shiftableNodeIDs, "Node IDs can only be shifted if the created nodes are recorded.");
+	for (std::weak_ptr<ASTNode> const& node: m_createdNodes)
+		if (auto const liveNode = node.lock())
+			liveNode->m_id += static_cast<size_t>(_offset);
+	m_currentNodeID += _offset;
+}
+
 ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
 {
 	solAssert(!m_insideModifier, "");
@@ -1478,7 +1491,10 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 		BOOST_THROW_EXCEPTION(FatalError());
 
 	location.end = nativeLocationOf(*block).end;
-	return std::make_shared<InlineAssembly>(nextID(), location, _docString, dialect, std::move(flags), block);
+	auto inlineAssembly = std::make_shared<InlineAssembly>(nextID(), location, _docString, dialect, std::move(flags), block);
+	if (m_shiftableNodeIDs)
+		m_createdNodes.push_back(inlineAssembly);
+	return inlineAssembly;
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
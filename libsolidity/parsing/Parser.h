@@ -38,18 +38,32 @@ namespace solidity::frontend
 class Parser: public langutil::ParserBase
 {
 public:
+	/// @param _previousMaxID IDs of the created nodes are larger than this value. Allows nodes
+	/// to be added to ASTs that were created by another parser without clashing IDs.
+	/// @param _shiftableNodeIDs if true, the created nodes are recorded, so that their IDs can
+	/// be changed later by shiftNodeIDs().
 	explicit Parser(
 		langutil::ErrorReporter& _errorReporter,
-		langutil::EVMVersion _evmVersion
+		langutil::EVMVersion _evmVersion,
+		int64_t _previousMaxID = 0,
+		bool _shiftableNodeIDs = false
 	):
 		ParserBase(_errorReporter),
-		m_evmVersion(_evmVersion)
+		m_evmVersion(_evmVersion),
+		m_currentNodeID(_previousMaxID),
+		m_shiftableNodeIDs(_shiftableNodeIDs)
 	{}
 
 	ASTPointer<SourceUnit> parse(langutil::CharStream& _charStream);
 
 	/// Returns the maximal AST node ID assigned so far
 	int64_t maxID() const { return m_currentNodeID; }
+
+	/// Adds @a _offset to the IDs of all nodes created by this parser so far and to maxID().
+	/// Allows sources to be parsed independently and numbered as if they had been parsed by a
+	/// single parser one after the other.
+	/// Requires the parser to be constructed with shiftable node IDs.
+	void shiftNodeIDs(int64_t _offset);
 private:
 	class ASTNodeFactory;
 
@@ -249,6 +263,11 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	/// Whether the created nodes are recorded in m_createdNodes.
+	bool m_shiftableNodeIDs = false;
+	/// All nodes created so far, including the ones that were discarded again, see shiftNodeIDs().
+	/// Only recorded if the node IDs are shiftable.
+	std::vector<std::weak_ptr<ASTNode>> m_createdNodes;
 	/// Flag that indicates whether experimental mode is enabled in the current source unit
 	bool m_experimentalSolidityEnabledInCurrentSourceUnit = false;
 };
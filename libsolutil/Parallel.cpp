@@ -0,0 +1,238 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using namespace solidity;
+
+namespace
+{
+
+/// A call of parallelFor. The calling thread works on it and idle threads of the WorkerPool
+/// can join in until the calling thread runs out of tasks.
+class Job
+{
+public:
+	Job(size_t _count, std::function<void(size_t)> const& _task):
+		m_count(_count),
+		m_task(_task),
+		m_failedIndex(_count)
+	{}
+
+	/// Called by a worker thread. Does nothing if the calling thread has already finished.
+	void help()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_finished)
+				return;
+			++m_helpers;
+		}
+		work();
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			--m_helpers;
+		}
+		m_helpersDone.notify_all();
+	}
+
+	/// Called by the calling thread. Runs tasks until there are none left, waits for the workers
+	/// still running tasks and rethrows the exception of the task with the smallest index, if any.
+	void run()
+	{
+		work();
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_finished = true;
+			m_helpersDone.wait(lock, [&]() { return m_helpers == 0; });
+		}
+		if (m_failure)
+			std::rethrow_exception(m_failure);
+	}
+
+private:
+	void work()
+	{
+		while (!m_failed.load())
+		{
+			size_t const index = m_nextIndex.fetch_add(1);
+			if (index >= m_count)
+				return;
+			try
+			{
+				m_task(index);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (index < m_failedIndex)
+				{
+					m_failedIndex = index;
+					m_failure = std::current_exception();
+				}
+				m_failed.store(true);
+			}
+		}
+	}
+
+	size_t const m_count;
+	/// Owned by the calling thread, which does not return before all workers stopped using it.
+	std::function<void(size_t)> const& m_task;
+	std::atomic<size_t> m_nextIndex{0};
+	std::atomic<bool> m_failed{false};
+
+	std::mutex m_mutex;
+	std::condition_variable m_helpersDone;
+	/// Set once the calling thread ran out of tasks. No worker joins in afterwards.
+	bool m_finished = false;
+	/// Number of workers currently working on the job.
+	size_t m_helpers = 0;
+	size_t m_failedIndex;
+	std::exception_ptr m_failure;
+};
+
+/// Threads that are kept alive between calls of parallelFor. Starting threads for every call
+/// is expensive for short calls and loses the thread-local state of the tasks, e.g. the
+/// simplification rules of the Yul optimizer, which are then built again on every call.
+/// The pool grows to the largest number of helpers requested at once.
+class WorkerPool
+{
+public:
+	static WorkerPool& instance()
+	{
+		static WorkerPool pool;
+		return pool;
+	}
+
+	~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_requestAvailable.notify_all();
+		for (std::thread& thread: m_threads)
+			thread.join();
+	}
+
+	/// Asks up to @a _helpers idle workers to join in on @a _job, starting new workers if there
+	/// are not enough idle ones. Starting fewer or none is not an error, the calling thread
+	/// always works on the job as well.
+	void request(std::shared_ptr<Job> const& _job, size_t _helpers)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (size_t i = 0; i < _helpers; ++i)
+				m_requests.push_back(_job);
+			for (size_t i = m_idle; i < _helpers; ++i)
+				try
+				{
+					m_threads.emplace_back([this]() { serve(); });
+					++m_idle;
+				}
+				catch (std::system_error const&)
+				{
+					// Could not spawn more threads, make do with the ones we have.
+					break;
+				}
+		}
+		m_requestAvailable.notify_all();
+	}
+
+	/// Drops the requests for @a _job that no worker has taken yet.
+	void withdraw(std::shared_ptr<Job> const& _job)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_requests.erase(std::remove(m_requests.begin(), m_requests.end(), _job), m_requests.end());
+	}
+
+private:
+	WorkerPool() = default;
+
+	void serve()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (true)
+		{
+			m_requestAvailable.wait(lock, [&]() { return m_stopping || !m_requests.empty(); });
+			if (m_requests.empty())
+				return;
+			std::shared_ptr<Job> job = std::move(m_requests.front());
+			m_requests.pop_front();
+			--m_idle;
+			lock.unlock();
+			job->help();
+			job.reset();
+			lock.lock();
+			++m_idle;
+		}
+	}
+
+	std::mutex m_mutex;
+	std::condition_variable m_requestAvailable;
+	std::deque<std::shared_ptr<Job>> m_requests;
+	std::vector<std::thread> m_threads;
+	/// Number of workers waiting for requests, including those that are just starting.
+	size_t m_idle = 0;
+	bool m_stopping = false;
+};
+
+}
+
+void util::parallelFor(size_t _count, size_t _concurrency, std::function<void(size_t)> const& _task)
+{
+	size_t const threadCount = std::min(_count, _concurrency);
+	if (threadCount <= 1)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_task(i);
+		return;
+	}
+
+	// Workers that are busy with other calls, e.g. with the call this one is nested in, are not
+	// waited for. The job is finished by whichever threads are available, at least this one.
+	auto job = std::make_shared<Job>(_count, _task);
+	WorkerPool& pool = WorkerPool::instance();
+	pool.request(job, threadCount - 1);
+	try
+	{
+		job->run();
+	}
+	catch (...)
+	{
+		pool.withdraw(job);
+		throw;
+	}
+	pool.withdraw(job);
+}
+
+size_t util::hardwareConcurrency()
+{
+	return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
@@ -0,0 +1,44 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Helpers for running independent pieces of work on multiple threads.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace solidity::util
+{
+
+/// Calls @a _task for every index in [0, _count) and returns once all calls have finished.
+/// The calls are distributed over at most @a _concurrency threads, one of which is the calling
+/// thread. The other threads are taken from a pool of threads that is kept alive between calls.
+/// With a concurrency of at most one or fewer than two tasks, everything runs on the calling
+/// thread in increasing index order. Calls can be nested.
+///
+/// Tasks must not depend on each other. If tasks throw, no further tasks are started and the
+/// exception of the task with the smallest index is rethrown in the calling thread. Since indices
+/// are handed out in increasing order, this is the same exception a sequential run would throw.
+void parallelFor(size_t _count, size_t _concurrency, std::function<void(size_t)> const& _task);
+
+/// @returns the number of threads that can run concurrently on this machine, at least one.
+size_t hardwareConcurrency();
+
+}
@@ -0,0 +1,187 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/TimeReport.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace solidity;
+using namespace solidity::util;
+
+namespace
+{
+/// Innermost stage alive on the current thread.
+thread_local TimeReport::Stage* t_innermostStage = nullptr;
+}
+
+TimeReport::Stage::Stage(TimeReport* _report, std::string _name, std::string _contract):
+	m_report(_report)
+{
+	m_event.name = std::move(_name);
+	m_event.contract = std::move(_contract);
+	start();
+}
+
+TimeReport::Stage::Stage(std::string _name, std::string _object)
+{
+	if (t_innermostStage)
+	{
+		m_report = t_innermostStage->m_report;
+		m_event.contract = t_innermostStage->m_event.contract;
+	}
+	m_event.name = std::move(_name);
+	m_event.object = std::move(_object);
+	start();
+}
+
+void TimeReport::Stage::start()
+{
+	if (!m_report)
+		return;
+
+	m_parent = t_innermostStage;
+	if (m_parent)
+		m_event.depth = m_parent->m_event.depth + 1;
+	t_innermostStage = this;
+	m_startTime = std::chrono::steady_clock::now();
+}
+
+TimeReport::Stage::~Stage()
+{
+	if (!m_report)
+		return;
+
+	auto const endTime = std::chrono::steady_clock::now();
+	m_event.start = std::chrono::duration_cast<std::chrono::microseconds>(m_startTime - m_report->m_startTime);
+	m_event.duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - m_startTime);
+	m_event.peakRSS = peakRSS();
+	t_innermostStage = m_parent;
+	m_report->record(std::move(m_event));
+}
+
+std::vector<TimeReport::Event> TimeReport::events() const
+{
+	std::vector<Event> events;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		events = m_events;
+	}
+	// Enclosing stages are recorded after the stages they contain, but have to come first.
+	std::stable_sort(events.begin(), events.end(), [](Event const& _a, Event const& _b) {
+		return std::make_pair(_a.start, _a.depth) < std::make_pair(_b.start, _b.depth);
+	});
+	return events;
+}
+
+Json TimeReport::chromeTrace() const
+{
+	Json traceEvents = Json::array();
+	for (Event const& event: events())
+	{
+		Json args = Json::object();
+		if (!event.contract.empty())
+			args["contract"] = event.contract;
+		if (!event.object.empty())
+			args["object"] = event.object;
+		if (event.peakRSS != 0)
+			args["peakRSS"] = event.peakRSS;
+
+		Json traceEvent;
+		traceEvent["name"] = event.name;
+		traceEvent["cat"] = event.contract.empty() ? "compiler" : event.contract;
+		traceEvent["ph"] = "X";
+		traceEvent["ts"] = event.start.count();
+		traceEvent["dur"] = event.duration.count();
+		traceEvent["pid"] = 1;
+		traceEvent["tid"] = event.thread;
+		traceEvent["args"] = std::move(args);
+		traceEvents.emplace_back(std::move(traceEvent));
+	}
+
+	Json trace;
+	trace["traceEvents"] = std::move(traceEvents);
+	trace["displayTimeUnit"] = "ms";
+	return trace;
+}
+
+std::string TimeReport::format() const
+{
+	std::vector<Event> const allEvents = events();
+
+	// Contracts in the order in which their first stage started.
+	std::vector<std::string> contracts;
+	for (Event const& event: allEvents)
+		if (std::find(contracts.begin(), contracts.end(), event.contract) == contracts.end())
+			contracts.push_back(event.contract);
+
+	std::string result;
+	for (std::string const& contract: contracts)
+	{
+		result += (contract.empty() ? "All sources" : contract) + ":\n";
+
+		size_t minDepth = std::numeric_limits<size_t>::max();
+		for (Event const& event: allEvents)
+			if (event.contract == contract)
+				minDepth = std::min(minDepth, event.depth);
+
+		for (Event const& event: allEvents)
+			if (event.contract == contract)
+			{
+				result += std::string(2 * (event.depth - minDepth + 1), ' ') + event.name;
+				if (!event.object.empty())
+					result += " (" + event.object + ")";
+				result += fmt::format(": {:.3f} ms", static_cast<double>(event.duration.count()) / 1000.0);
+				if (event.peakRSS != 0)
+					result += fmt::format(", peak RSS {:.1f} MiB", static_cast<double>(event.peakRSS) / (1024.0 * 1024.0));
+				result += "\n";
+			}
+	}
+	return result;
+}
+
+size_t TimeReport::peakRSS()
+{
+#if defined(__linux__) || defined(__APPLE__)
+	rusage usage{};
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#if defined(__APPLE__)
+	// Reported in bytes on macOS...
+	return static_cast<size_t>(usage.ru_maxrss);
+#else
+	// ...and in kilobytes on Linux.
+	return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+	return 0;
+#endif
+}
+
+void TimeReport::record(Event _event)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	_event.thread = m_threadNumbers.emplace(std::this_thread::get_id(), m_threadNumbers.size()).first->second;
+	m_events.emplace_back(std::move(_event));
+}
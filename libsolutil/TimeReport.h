@@ -0,0 +1,118 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Collects the wall time and memory usage of the stages of a compilation.
+ */
+
+#pragma once
+
+#include <libsolutil/JSON.h>
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Record of the stages of a compilation. Stages are measured by creating a TimeReport::Stage
+ * object, which records the stage when it is destroyed. Stages can be recorded from several
+ * threads concurrently.
+ */
+class TimeReport
+{
+public:
+	struct Event
+	{
+		std::string name;
+		/// Fully qualified name of the contract the stage belongs to.
+		/// Empty for stages that concern all sources.
+		std::string contract;
+		/// Name of the part of the contract the stage belongs to, e.g. a Yul object. May be empty.
+		std::string object;
+		/// Number of stages this one is nested in.
+		size_t depth = 0;
+		/// Number of the thread the stage ran on, in the order in which the threads were first seen.
+		size_t thread = 0;
+		/// Start of the stage, relative to the creation of the report.
+		std::chrono::microseconds start{};
+		std::chrono::microseconds duration{};
+		/// Peak resident set size of the process at the end of the stage, in bytes.
+		/// Zero if not available on this platform.
+		size_t peakRSS = 0;
+	};
+
+	/**
+	 * Measures a stage from its construction to its destruction.
+	 * While a stage is alive, stages that are started on the same thread without naming a report
+	 * are nested in it and belong to the same report and contract. This allows code that has no
+	 * access to the report to contribute stages.
+	 */
+	class Stage
+	{
+	public:
+		/// Starts a stage of @a _report. Does nothing if @a _report is null.
+		Stage(TimeReport* _report, std::string _name, std::string _contract = {});
+		/// Starts a stage nested in the innermost stage alive on this thread.
+		/// Does nothing if there is no such stage.
+		explicit Stage(std::string _name, std::string _object = {});
+		~Stage();
+
+		Stage(Stage const&) = delete;
+		Stage& operator=(Stage const&) = delete;
+
+	private:
+		void start();
+
+		TimeReport* m_report = nullptr;
+		Stage* m_parent = nullptr;
+		Event m_event;
+		std::chrono::steady_clock::time_point m_startTime;
+	};
+
+	TimeReport(): m_startTime(std::chrono::steady_clock::now()) {}
+
+	/// @returns all stages recorded so far, ordered by their start.
+	std::vector<Event> events() const;
+
+	/// @returns the stages in the Trace Event Format understood by Chrome's tracing tools and
+	/// Perfetto, as an object with a "traceEvents" member.
+	Json chromeTrace() const;
+
+	/// @returns a human-readable listing of the stages, grouped by contract.
+	std::string format() const;
+
+	/// @returns the peak resident set size of this process so far in bytes, or zero if it
+	/// is not available on this platform.
+	static size_t peakRSS();
+
+private:
+	void record(Event _event);
+
+	std::chrono::steady_clock::time_point const m_startTime;
+	mutable std::mutex m_mutex;
+	std::vector<Event> m_events;
+	std::map<std::thread::id, size_t> m_threadNumbers;
+};
+
+}
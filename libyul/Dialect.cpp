@@ -22,6 +22,8 @@
 #include <libyul/Dialect.h>
 #include <libyul/AST.h>
 
+#include <mutex>
+
 using namespace solidity::yul;
 using namespace solidity::langutil;
 
@@ -53,6 +55,8 @@ Dialect const& Dialect::yulDeprecated()
 {
 	static std::unique_ptr<Dialect> dialect;
 	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
+	static std::mutex mutex;
+	std::lock_guard<std::mutex> lock(mutex);
 
 	if (!dialect)
 	{
@@ -0,0 +1,51 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/OptimizedCodeCache.h>
+
+#include <libyul/AST.h>
+#include <libyul/optimiser/ASTCopier.h>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+std::shared_ptr<Block const> OptimizedCodeCache::find(util::h256 const& _key) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it = m_optimizedCode.find(_key);
+	if (it == m_optimizedCode.end())
+		return nullptr;
+	return it->second;
+}
+
+void OptimizedCodeCache::insert(util::h256 const& _key, Block const& _optimizedCode)
+{
+	insert(_key, std::make_shared<Block const>(std::get<Block>(ASTCopier{}(_optimizedCode))));
+}
+
+void OptimizedCodeCache::insert(util::h256 const& _key, std::shared_ptr<Block const> _optimizedCode)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_optimizedCode.emplace(_key, std::move(_optimizedCode));
+}
+
+size_t OptimizedCodeCache::size() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_optimizedCode.size();
+}
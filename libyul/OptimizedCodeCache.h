@@ -0,0 +1,64 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for the optimized code of Yul objects and functions.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace solidity::yul
+{
+
+/**
+ * Stores the code of Yul objects after optimization, keyed by a hash of the unoptimized code
+ * and of everything else the optimization depends on.
+ *
+ * The IR of a contract embeds the full IR of every contract it creates, so without the cache
+ * a contract created from many places is optimized once for every one of them.
+ * Can be shared between YulStacks of the same compilation and used from multiple threads.
+ *
+ * The FunctionStepMemoizer also stores the results of single optimiser steps on small functions
+ * here, in a block after the function they were computed from, so that helper functions shared
+ * by many contracts are only optimized once.
+ */
+class OptimizedCodeCache
+{
+public:
+	/// @returns the optimized code stored under @a _key or nullptr if there is none.
+	std::shared_ptr<Block const> find(util::h256 const& _key) const;
+	/// Stores a copy of @a _optimizedCode under @a _key.
+	void insert(util::h256 const& _key, Block const& _optimizedCode);
+	/// Stores @a _optimizedCode under @a _key without copying it.
+	void insert(util::h256 const& _key, std::shared_ptr<Block const> _optimizedCode);
+
+	size_t size() const;
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<util::h256, std::shared_ptr<Block const>> m_optimizedCode;
+};
+
+}
@@ -22,6 +22,7 @@
 
 #include <libyul/YulStack.h>
 
+#include <libyul/AST.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/backends/evm/EthAssemblyAdapter.h>
@@ -30,10 +31,14 @@
 #include <libyul/backends/evm/EVMObjectCompiler.h>
 #include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SequenceSearch.h>
 #include <libyul/optimiser/Suite.h>
 #include <libevmasm/Assembly.h>
 #include <liblangutil/Scanner.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/TimeReport.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 
 #include <boost/algorithm/string.hpp>
@@ -188,7 +193,15 @@ void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
 			break;
 	}
 
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize, m_eofVersion);
+	EVMObjectCompiler::compile(
+		*m_parserResult,
+		_assembly,
+		*dialect,
+		_optimize,
+		m_eofVersion,
+		m_optimiserSettings.stackLayoutSearchEffort,
+		m_concurrency
+	);
 }
 
 void YulStack::optimize(Object& _object, bool _isCreation)
@@ -202,7 +215,18 @@ void YulStack::optimize(Object& _object, bool _isCreation)
 			optimize(*subObject, isCreation);
 		}
 
+	util::TimeReport::Stage stage("Yul optimization", _object.name);
 	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
+
+	std::optional<util::h256> cacheKey = optimizedCodeCacheKey(_object, _isCreation);
+	if (cacheKey)
+		if (std::shared_ptr<Block const> cachedCode = m_optimizedCodeCache->find(*cacheKey))
+		{
+			*_object.code = std::get<Block>(ASTCopier{}(*cachedCode));
+			*_object.analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(dialect, _object);
+			return;
+		}
+
 	std::unique_ptr<GasMeter> meter;
 	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
 		meter = std::make_unique<GasMeter>(*evmDialect, _isCreation, m_optimiserSettings.expectedExecutionsPerDeployment);
@@ -232,6 +256,20 @@ void YulStack::optimize(Object& _object, bool _isCreation)
 		);
 	}();
 
+	if (m_optimiserSettings.runYulOptimiser && m_optimiserSettings.yulOptimiserSearchBudget > 0)
+		yulOptimiserSteps = OptimiserSequenceSearch::run(
+			dialect,
+			meter.get(),
+			_object,
+			optimizeStackAllocation,
+			yulOptimiserSteps,
+			yulOptimiserCleanupSteps,
+			_isCreation ? std::nullopt : std::make_optional(m_optimiserSettings.expectedExecutionsPerDeployment),
+			m_optimiserSettings.yulOptimiserSearchBudget,
+			m_concurrency,
+			m_optimiserSettings.yulOptimiserInlineBudget
+		);
+
 	OptimiserSuite::run(
 		dialect,
 		meter.get(),
@@ -241,8 +279,57 @@ void YulStack::optimize(Object& _object, bool _isCreation)
 		yulOptimiserSteps,
 		yulOptimiserCleanupSteps,
 		_isCreation ? std::nullopt : std::make_optional(m_optimiserSettings.expectedExecutionsPerDeployment),
-		{}
+		{},
+		m_optimiserStepProfile.get(),
+		m_concurrency,
+		m_optimizedCodeCache.get(),
+		m_optimiserSettings.stackLayoutSearchEffort,
+		m_optimiserSettings.yulOptimiserInlineBudget
 	);
+
+	if (cacheKey)
+		m_optimizedCodeCache->insert(*cacheKey, *_object.code);
+}
+
+std::optional<util::h256> YulStack::optimizedCodeCacheKey(Object const& _object, bool _isCreation) const
+{
+	// Without source names, the source locations in the comments could not be told apart, and
+	// would then be taken from whichever object was optimized first.
+	if (!m_optimizedCodeCache || !m_charStream || !_object.debugData || !_object.debugData->sourceNames)
+		return std::nullopt;
+
+	// The code has not been modified since parsing, so it is fully determined by its source text
+	// together with the debug data the parser carried over from the comments preceding the block.
+	DebugData::ConstPtr const& debugData = _object.code->debugData;
+	if (
+		!debugData ||
+		!debugData->nativeLocation.hasText() ||
+		*debugData->nativeLocation.sourceName != m_charStream->name()
+	)
+		return std::nullopt;
+
+	std::string key(m_charStream->text(debugData->nativeLocation));
+	SourceLocation const& origin = debugData->originLocation;
+	key += "\n" + (origin.sourceName ? *origin.sourceName : "-");
+	key += ":" + std::to_string(origin.start) + ":" + std::to_string(origin.end);
+	key += "\n" + (debugData->astID ? std::to_string(*debugData->astID) : "-");
+	for (auto const& [index, sourceName]: *_object.debugData->sourceNames)
+		key += "\n" + std::to_string(index) + ":" + *sourceName;
+	for (std::string const& dataName: _object.qualifiedDataNames())
+		key += "\n" + dataName;
+	key += "\n" + m_evmVersion.name();
+	key += "\n" + (m_eofVersion.has_value() ? std::to_string(*m_eofVersion) : "-");
+	key += "\n" + std::to_string(static_cast<int>(m_language));
+	key += "\n" + std::string(_isCreation ? "creation" : "runtime");
+	key += "\n" + std::to_string(m_optimiserSettings.runYulOptimiser);
+	key += "\n" + std::to_string(m_optimiserSettings.optimizeStackAllocation);
+	key += "\n" + m_optimiserSettings.yulOptimiserSteps;
+	key += "\n" + m_optimiserSettings.yulOptimiserCleanupSteps;
+	key += "\n" + std::to_string(m_optimiserSettings.yulOptimiserSearchBudget);
+	key += "\n" + std::to_string(m_optimiserSettings.stackLayoutSearchEffort);
+	key += "\n" + (m_optimiserSettings.yulOptimiserInlineBudget ? std::to_string(*m_optimiserSettings.yulOptimiserInlineBudget) : "-");
+	key += "\n" + std::to_string(m_optimiserSettings.expectedExecutionsPerDeployment);
+	return util::keccak256(key);
 }
 
 MachineAssemblyObject YulStack::assemble(Machine _machine)
@@ -322,9 +409,18 @@ YulStack::assembleEVMWithDeployed(std::optional<std::string_view> _deployName)
 	);
 	try
 	{
-		compileEVM(adapter, optimize);
+		{
+			util::TimeReport::Stage stage("EVM code transform");
+			compileEVM(adapter, optimize);
+		}
 
-		assembly.optimise(evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion));
+		{
+			util::TimeReport::Stage stage("evmasm optimization");
+			assembly.optimise(
+				evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion),
+				m_concurrency
+			);
+		}
 
 		std::optional<size_t> subIndex;
 
@@ -29,6 +29,9 @@
 
 #include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/OptimizedCodeCache.h>
+#include <libyul/YulString.h>
+#include <libyul/optimiser/OptimiserStepProfile.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
@@ -109,6 +112,19 @@ public:
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
 	void optimize();
 
+	/// Sets a cache that @a optimize uses to skip optimizing objects whose code was already
+	/// optimized by this or another YulStack with the same settings.
+	void setOptimizedCodeCache(std::shared_ptr<OptimizedCodeCache> _cache) { m_optimizedCodeCache = std::move(_cache); }
+
+	/// Sets a profile in which @a optimize records every optimiser step it runs.
+	void setOptimiserStepProfile(std::shared_ptr<OptimiserStepProfile> _profile) { m_optimiserStepProfile = std::move(_profile); }
+	std::shared_ptr<OptimiserStepProfile const> optimiserStepProfile() const { return m_optimiserStepProfile; }
+
+	/// Sets the maximum number of threads @a optimize uses to run function-local optimiser steps
+	/// on the functions of an object and the assembly step uses to generate and optimise the
+	/// code of sub-objects. Does not affect the result.
+	void setConcurrency(size_t _concurrency) { m_concurrency = _concurrency; }
+
 	/// Run the assembly step (should only be called after parseAndAnalyze).
 	MachineAssemblyObject assemble(Machine _machine);
 
@@ -148,9 +164,15 @@ private:
 	void compileEVM(yul::AbstractAssembly& _assembly, bool _optimize) const;
 
 	void optimize(yul::Object& _object, bool _isCreation);
+	/// @returns the key of the optimized code of @a _object in the optimized code cache, if it can be cached.
+	std::optional<util::h256> optimizedCodeCacheKey(yul::Object const& _object, bool _isCreation) const;
 
 	void reportUnimplementedFeatureError(langutil::UnimplementedFeatureError const& _error);
 
+	/// Keeps the YulStrings of the parsed and optimized code valid. Declared first, so that it is
+	/// released last. A pointer, so that the stack stays movable.
+	std::unique_ptr<YulStringRepository::UsageGuard> m_yulStringGuard = std::make_unique<YulStringRepository::UsageGuard>();
+
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
 	std::optional<uint8_t> m_eofVersion;
@@ -165,6 +187,10 @@ private:
 	langutil::ErrorReporter m_errorReporter;
 
 	std::unique_ptr<std::string> m_sourceMappings;
+
+	std::shared_ptr<OptimizedCodeCache> m_optimizedCodeCache;
+	std::shared_ptr<OptimiserStepProfile> m_optimiserStepProfile;
+	size_t m_concurrency = 1;
 };
 
 }
@@ -0,0 +1,206 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/YulString.h>
+
+#include <libyul/Exceptions.h>
+
+#include <memory>
+
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Entry of the per-thread lookup cache. Only valid if the generation matches the
+/// generation of the repository.
+struct CacheEntry
+{
+	size_t generation = 0;
+	std::uint64_t hash = 0;
+	size_t id = 0;
+};
+
+constexpr size_t CacheSize = 1024;
+
+std::array<CacheEntry, CacheSize>& threadCache()
+{
+	thread_local std::array<CacheEntry, CacheSize> cache;
+	return cache;
+}
+
+/// Number of UsageGuards alive in the calling thread.
+size_t& threadUsages()
+{
+	thread_local size_t usages = 0;
+	return usages;
+}
+
+}
+
+YulStringRepository::YulStringRepository()
+{
+	for (auto& chunk: m_chunks)
+		chunk.store(nullptr, std::memory_order_relaxed);
+	// Allocates the first chunk, whose first slot is the empty string.
+	chunkForNewID(0);
+}
+
+YulStringRepository::~YulStringRepository()
+{
+	for (auto& chunk: m_chunks)
+		delete[] chunk.load(std::memory_order_relaxed);
+}
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(std::string const& _string)
+{
+	if (_string.empty())
+		return {0, emptyHash()};
+	std::uint64_t h = hash(_string);
+
+	size_t generation = m_generation.load(std::memory_order_acquire);
+	CacheEntry& cached = threadCache()[h % CacheSize];
+	if (cached.generation == generation && cached.hash == h && idToString(cached.id) == _string)
+		return {cached.id, h};
+
+	Shard& shard = m_shards[(h ^ (h >> 32)) % ShardCount];
+	size_t id = 0;
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		auto range = shard.hashToID.equal_range(h);
+		for (auto it = range.first; it != range.second && id == 0; ++it)
+			if (idToString(it->second) == _string)
+				id = it->second;
+		if (id == 0)
+		{
+			id = m_nextID.fetch_add(1, std::memory_order_relaxed);
+			yulAssert(
+				id < MaxChunks * ChunkSize,
+				"Too many distinct Yul identifiers are in use by the compilations running in this process."
+			);
+			// The string has to be in place before the ID can be found by other threads.
+			chunkForNewID(id)[id % ChunkSize] = _string;
+			shard.hashToID.emplace_hint(range.second, h, id);
+		}
+	}
+
+	cached = {generation, h, id};
+	return {id, h};
+}
+
+void YulStringRepository::reset()
+{
+	// Waiting for the guards to be released would never end.
+	yulAssert(threadUsages() == 0, "The YulString repository cannot be reset by a thread that uses it.");
+	YulStringRepository& repository = instance();
+	std::unique_lock<std::mutex> lock(repository.m_usageMutex);
+	// Another thread may already be waiting to reset the repository.
+	repository.m_usageChanged.wait(lock, [&]() { return !repository.m_draining; });
+	repository.drainAndReset(lock);
+}
+
+bool YulStringRepository::resetIfUnused()
+{
+	YulStringRepository& repository = instance();
+	std::unique_lock<std::mutex> lock(repository.m_usageMutex);
+	if (repository.m_users > 0 || repository.m_draining)
+		return false;
+	repository.drainAndReset(lock);
+	return true;
+}
+
+void YulStringRepository::acquireUsage()
+{
+	std::unique_lock<std::mutex> lock(m_usageMutex);
+	// The enclosing guard of this thread keeps the repository alive. Waiting for the other
+	// guards to be released would include that one.
+	if (threadUsages() == 0)
+	{
+		m_usageChanged.wait(lock, [&]() { return !m_draining; });
+		if (m_nextID.load(std::memory_order_relaxed) > m_resetThreshold.load(std::memory_order_relaxed))
+			drainAndReset(lock);
+	}
+	++m_users;
+	++threadUsages();
+}
+
+void YulStringRepository::releaseUsage()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_usageMutex);
+		yulAssert(m_users > 0 && threadUsages() > 0);
+		--m_users;
+		--threadUsages();
+	}
+	m_usageChanged.notify_all();
+}
+
+void YulStringRepository::addResetCallback(std::function<void()> _callback)
+{
+	std::lock_guard<std::mutex> lock(m_usageMutex);
+	m_resetCallbacks.emplace_back(std::move(_callback));
+}
+
+void YulStringRepository::drainAndReset(std::unique_lock<std::mutex>& _lock)
+{
+	m_draining = true;
+	m_usageChanged.wait(_lock, [&]() { return m_users == 0; });
+	for (auto const& cb: m_resetCallbacks)
+		cb();
+	clear();
+	m_draining = false;
+	m_usageChanged.notify_all();
+}
+
+void YulStringRepository::clear()
+{
+	for (Shard& shard: m_shards)
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		shard.hashToID.clear();
+	}
+	for (auto& chunk: m_chunks)
+		delete[] chunk.exchange(nullptr, std::memory_order_acq_rel);
+	chunkForNewID(0);
+	m_nextID.store(1, std::memory_order_relaxed);
+	m_generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void YulStringRepository::reportInvalidID(size_t _id)
+{
+	yulAssert(false, "YulString ID " + std::to_string(_id) + " is out of range. The repository may have been reset.");
+}
+
+std::string* YulStringRepository::chunkForNewID(size_t _id)
+{
+	std::atomic<std::string*>& slot = m_chunks[_id / ChunkSize];
+	std::string* chunk = slot.load(std::memory_order_acquire);
+	if (chunk)
+		return chunk;
+
+	auto freshChunk = std::make_unique<std::string[]>(ChunkSize);
+	if (slot.compare_exchange_strong(
+		chunk,
+		freshChunk.get(),
+		std::memory_order_acq_rel,
+		std::memory_order_acquire
+	))
+		return freshChunk.release();
+	// Another thread allocated the chunk first.
+	return chunk;
+}
@@ -23,11 +23,15 @@
 
 #include <fmt/format.h>
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
 #include <unordered_map>
-#include <memory>
 #include <vector>
-#include <string>
-#include <functional>
 
 namespace solidity::yul
 {
@@ -36,6 +40,16 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+///
+/// The repository can be used from multiple threads concurrently. Strings are stored in chunks
+/// that never move, so that looking up the string of an ID does not need any synchronization.
+/// Interning a string first consults a small per-thread cache and then a hash table that is
+/// split into independently locked shards. IDs stay stable until the repository is reset.
+///
+/// Compilations hold a UsageGuard. The repository is only reset while no guard is alive. Once it
+/// holds more than a threshold of strings, new guards wait until the existing ones are released
+/// and reset the repository first, so that its size stays bounded even if compilations overlap
+/// all the time.
 class YulStringRepository
 {
 public:
@@ -51,22 +65,15 @@ public:
 		return inst;
 	}
 
-	Handle stringToHandle(std::string const& _string)
+	~YulStringRepository();
+
+	Handle stringToHandle(std::string const& _string);
+	std::string const& idToString(size_t _id) const
 	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		if (_id >= m_nextID.load(std::memory_order_relaxed) || (_id >> ChunkBits) >= MaxChunks)
+			reportInvalidID(_id);
+		return m_chunks[_id >> ChunkBits].load(std::memory_order_acquire)[_id & (ChunkSize - 1)];
 	}
-	std::string const& idToString(size_t _id) const { return *m_strings.at(_id); }
 
 	static std::uint64_t hash(std::string const& v)
 	{
@@ -85,37 +92,102 @@ public:
 	/// Use with care - there cannot be any dangling YulString references.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
-	static void reset()
+	/// Waits until no UsageGuard is alive and prevents new ones from being created meanwhile.
+	/// Must not be called by a thread that holds a UsageGuard.
+	static void reset();
+	/// Clears the repository like reset(), but only if no UsageGuard is alive in any thread.
+	/// @returns true if the repository was cleared.
+	static bool resetIfUnused();
+	/// Sets the number of strings above which new UsageGuards reset the repository.
+	/// @returns the previous value. Meant for tests.
+	static size_t setResetThreshold(size_t _threshold)
 	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
+		return instance().m_resetThreshold.exchange(_threshold, std::memory_order_relaxed);
 	}
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
+	/// Registration is synchronized with resets happening in other threads.
 	struct ResetCallback
 	{
 		ResetCallback(std::function<void()> _fun)
 		{
-			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
+			instance().addResetCallback(std::move(_fun));
 		}
 	};
+	/// Prevents the repository from being reset while it is alive. CompilerStack and YulStack hold
+	/// one for as long as they exist, since their ASTs contain YulStrings.
+	/// Guards can be nested within one thread: only the outermost guard of a thread may wait for
+	/// the other guards to be released in order to reset the repository. A guard has to be
+	/// destroyed by the thread that created it. Threads that work on behalf of a thread holding
+	/// a guard, e.g. the workers of parallelFor, are covered by that guard and must not create
+	/// guards of their own, since these could wait for the enclosing guard to be released.
+	class UsageGuard
+	{
+	public:
+		UsageGuard() { instance().acquireUsage(); }
+		~UsageGuard() { instance().releaseUsage(); }
+		UsageGuard(UsageGuard const&) = delete;
+		UsageGuard& operator=(UsageGuard const&) = delete;
+	};
 
 private:
-	YulStringRepository() = default;
+	/// Number of bits of an ID that select the slot within a chunk.
+	static constexpr size_t ChunkBits = 12;
+	static constexpr size_t ChunkSize = size_t(1) << ChunkBits;
+	static constexpr size_t MaxChunks = size_t(1) << 14;
+	static constexpr size_t ShardCount = 64;
+	/// Default number of strings above which new UsageGuards wait for a reset. Far below the
+	/// capacity of MaxChunks * ChunkSize strings, so that the compilations still in flight can continue.
+	static constexpr size_t DefaultResetThreshold = size_t(1) << 22;
+
+	struct Shard
+	{
+		std::mutex mutex;
+		std::unordered_multimap<std::uint64_t, size_t> hashToID;
+	};
+
+	YulStringRepository();
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
 
-	static std::vector<std::function<void()>>& resetCallbacks()
-	{
-		static std::vector<std::function<void()>> callbacks;
-		return callbacks;
-	}
+	/// Adds a reset callback while holding m_usageMutex, which drainAndReset holds while calling them.
+	void addResetCallback(std::function<void()> _callback);
+
+	/// Registers a user. Unless the calling thread is already a user, first resets the repository
+	/// if it has grown beyond m_resetThreshold.
+	void acquireUsage();
+	void releaseUsage();
+	/// Waits until there are no users and blocks new ones while calling the reset callbacks
+	/// and clearing the repository. Expects m_usageMutex to be locked by @a _lock.
+	void drainAndReset(std::unique_lock<std::mutex>& _lock);
+	/// Clears all strings. Requires exclusive access.
+	void clear();
+	/// Throws a YulAssertion for an ID that was not handed out since the last reset.
+	static void reportInvalidID(size_t _id);
+	/// @returns the chunk that holds the string with ID @a _id, allocating it if necessary.
+	std::string* chunkForNewID(size_t _id);
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	/// Chunks of ChunkSize strings each. A chunk is never moved or freed before the repository is
+	/// cleared, so references to strings remain valid.
+	std::array<std::atomic<std::string*>, MaxChunks> m_chunks;
+	/// The next ID to be handed out. ID zero is reserved for the empty string.
+	std::atomic<size_t> m_nextID{1};
+	/// Incremented on every reset to invalidate the per-thread lookup caches.
+	std::atomic<size_t> m_generation{1};
+	/// Number of strings above which new UsageGuards wait for a reset.
+	std::atomic<size_t> m_resetThreshold{DefaultResetThreshold};
+	/// Maps hashes to IDs. The shard of a string is determined by its hash.
+	std::array<Shard, ShardCount> m_shards;
+	/// Protects m_users, m_draining and m_resetCallbacks.
+	std::mutex m_usageMutex;
+	/// Notified whenever m_users or m_draining changes.
+	std::condition_variable m_usageChanged;
+	/// Number of alive UsageGuards, including nested ones.
+	size_t m_users = 0;
+	/// True while waiting for the users to finish in order to reset the repository.
+	bool m_draining = false;
+	/// Functions called before the repository is cleared.
+	std::vector<std::function<void()>> m_resetCallbacks;
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -30,8 +30,15 @@
 #include <libyul/Object.h>
 #include <libyul/Exceptions.h>
 
+#include <libsolutil/Parallel.h>
+
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
 using namespace solidity::yul;
 
 void EVMObjectCompiler::compile(
@@ -39,10 +46,12 @@ void EVMObjectCompiler::compile(
 	AbstractAssembly& _assembly,
 	EVMDialect const& _dialect,
 	bool _optimize,
-	std::optional<uint8_t> _eofVersion
+	std::optional<uint8_t> _eofVersion,
+	size_t _stackLayoutSearchEffort,
+	size_t _concurrency
 )
 {
-	EVMObjectCompiler compiler(_assembly, _dialect, _eofVersion);
+	EVMObjectCompiler compiler(_assembly, _dialect, _eofVersion, _stackLayoutSearchEffort, _concurrency);
 	compiler.run(_object, _optimize);
 }
 
@@ -51,7 +60,7 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 	BuiltinContext context;
 	context.currentObject = &_object;
 
-
+	std::vector<std::pair<Object*, std::shared_ptr<AbstractAssembly>>> subObjectsAndAssemblies;
 	for (auto const& subNode: _object.subObjects)
 		if (auto* subObject = dynamic_cast<Object*>(subNode.get()))
 		{
@@ -59,7 +68,7 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 			auto subAssemblyAndID = m_assembly.createSubAssembly(isCreation, subObject->name);
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
 			subObject->subId = subAssemblyAndID.second;
-			compile(*subObject, *subAssemblyAndID.first, m_dialect, _optimize, m_eofVersion);
+			subObjectsAndAssemblies.emplace_back(subObject, subAssemblyAndID.first);
 		}
 		else
 		{
@@ -71,6 +80,14 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 				context.subIDs[data.name] = m_assembly.appendData(data.data);
 		}
 
+	// The sub-assemblies are only combined with this assembly when it is assembled, so the code
+	// of the sub-objects can be generated independently of each other.
+	size_t subConcurrency = std::max<size_t>(1, m_concurrency / std::max<size_t>(1, subObjectsAndAssemblies.size()));
+	util::parallelFor(subObjectsAndAssemblies.size(), m_concurrency, [&](size_t _index) {
+		auto&& [subObject, subAssembly] = subObjectsAndAssemblies[_index];
+		compile(*subObject, *subAssembly, m_dialect, _optimize, m_eofVersion, m_stackLayoutSearchEffort, subConcurrency);
+	});
+
 	yulAssert(_object.analysisInfo, "No analysis info.");
 	yulAssert(_object.code, "No code.");
 	if (m_eofVersion.has_value())
@@ -86,7 +103,8 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 			*_object.code,
 			m_dialect,
 			context,
-			OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName
+			OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName,
+			m_stackLayoutSearchEffort
 		);
 		if (!stackErrors.empty())
 		{
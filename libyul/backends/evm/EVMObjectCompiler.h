@@ -22,6 +22,7 @@
 #pragma once
 
 #include <optional>
+#include <cstddef>
 #include <cstdint>
 
 namespace solidity::yul
@@ -33,16 +34,32 @@ struct EVMDialect;
 class EVMObjectCompiler
 {
 public:
+	/// @a _stackLayoutSearchEffort is the number of rounds the optimized code transform may spend
+	/// on improving stack layouts at conditional jumps (see StackLayoutGenerator).
+	/// The code of sub-objects is generated on up to @a _concurrency threads. The result does
+	/// not depend on the number of threads.
 	static void compile(
 		Object& _object,
 		AbstractAssembly& _assembly,
 		EVMDialect const& _dialect,
 		bool _optimize,
-		std::optional<uint8_t> _eofVersion
+		std::optional<uint8_t> _eofVersion,
+		size_t _stackLayoutSearchEffort = 0,
+		size_t _concurrency = 1
 	);
 private:
-	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect, std::optional<uint8_t> _eofVersion):
-		m_assembly(_assembly), m_dialect(_dialect), m_eofVersion(_eofVersion)
+	EVMObjectCompiler(
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		std::optional<uint8_t> _eofVersion,
+		size_t _stackLayoutSearchEffort,
+		size_t _concurrency
+	):
+		m_assembly(_assembly),
+		m_dialect(_dialect),
+		m_eofVersion(_eofVersion),
+		m_stackLayoutSearchEffort(_stackLayoutSearchEffort),
+		m_concurrency(_concurrency)
 	{}
 
 	void run(Object& _object, bool _optimize);
@@ -50,6 +67,8 @@ private:
 	AbstractAssembly& m_assembly;
 	EVMDialect const& m_dialect;
 	std::optional<uint8_t> m_eofVersion;
+	size_t m_stackLayoutSearchEffort = 0;
+	size_t m_concurrency = 1;
 };
 
 }
@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/backends/evm/ShufflePlanCache.h>
+
+#include <limits>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+ShufflePlanCache& ShufflePlanCache::instance()
+{
+	thread_local ShufflePlanCache cache;
+	return cache;
+}
+
+ShufflePlanCache::Key ShufflePlanCache::key(Stack const& _source, Stack const& _target)
+{
+	Key result;
+	std::vector<StackSlot const*> distinctSlots;
+	computeKey(_source, _target, result, distinctSlots);
+	return result;
+}
+
+std::shared_ptr<ShufflePlan const> ShufflePlanCache::find(Stack const& _source, Stack const& _target)
+{
+	computeKey(_source, _target, m_lookupKey, m_distinctSlots);
+	auto it = m_plans.find(m_lookupKey);
+	if (it == m_plans.end())
+		return nullptr;
+	return it->second;
+}
+
+void ShufflePlanCache::insert(Key _key, ShufflePlan _plan)
+{
+	if (m_plans.size() >= maxPlans)
+		m_plans.clear();
+	m_plans.emplace(std::move(_key), std::make_shared<ShufflePlan const>(std::move(_plan)));
+}
+
+void ShufflePlanCache::computeKey(
+	Stack const& _source,
+	Stack const& _target,
+	Key& _key,
+	std::vector<StackSlot const*>& _distinctSlots
+)
+{
+	// Stacks are short, so a linear search is faster than any map.
+	_distinctSlots.clear();
+	auto number = [&](StackSlot const& _slot) -> uint32_t {
+		if (std::holds_alternative<JunkSlot>(_slot))
+			return 0;
+		for (size_t i = 0; i < _distinctSlots.size(); ++i)
+			if (*_distinctSlots[i] == _slot)
+				return static_cast<uint32_t>(i + 1);
+		_distinctSlots.emplace_back(&_slot);
+		return static_cast<uint32_t>(_distinctSlots.size());
+	};
+
+	_key.clear();
+	_key.reserve(_source.size() + _target.size() + 1);
+	for (StackSlot const& slot: _source)
+		_key.emplace_back(number(slot));
+	_key.emplace_back(std::numeric_limits<uint32_t>::max());
+	for (StackSlot const& slot: _target)
+		_key.emplace_back(number(slot));
+}
@@ -0,0 +1,96 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Per-thread cache of the stack shuffling operations computed by createStackLayout.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/ControlFlowGraph.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/// A single operation performed by createStackLayout.
+struct ShuffleOperation
+{
+	enum class Kind: uint8_t { Swap, PushOrDup, Pop };
+	Kind kind;
+	/// Depth of the swap for Kind::Swap, offset of the pushed or dupped slot in the target
+	/// stack for Kind::PushOrDup and zero for Kind::Pop.
+	size_t argument = 0;
+};
+using ShufflePlan = std::vector<ShuffleOperation>;
+
+/**
+ * Stores the operations that shuffle one stack layout to another, keyed by the pattern of the
+ * two layouts: The shuffler only looks at which slots are equal and which target slots are junk,
+ * so the same operations transform any pair of stacks with the same pattern, no matter which
+ * variables, literals or return labels the slots hold.
+ *
+ * Shared by the stack layout generator and the code transform of all compilations running on the
+ * same thread. Every thread has its own instance, so that lookups do not need any synchronization.
+ * Code generation for several contracts runs on the long-lived worker threads of parallelFor, so
+ * their caches stay populated between compilations.
+ */
+class ShufflePlanCache
+{
+public:
+	using Key = std::vector<uint32_t>;
+
+	/// @returns the cache of the calling thread.
+	static ShufflePlanCache& instance();
+
+	/// @returns the pattern of shuffling @a _source to @a _target: The slots are numbered in the
+	/// order of their first occurrence, starting at one, and junk slots are zero.
+	static Key key(Stack const& _source, Stack const& _target);
+
+	/// @returns the plan for shuffling @a _source to @a _target or nullptr if there is none.
+	/// The key is computed into a buffer that is reused by every call, see lastKey().
+	std::shared_ptr<ShufflePlan const> find(Stack const& _source, Stack const& _target);
+	/// @returns the key computed by the last call to find().
+	Key const& lastKey() const { return m_lookupKey; }
+	/// Stores @a _plan under @a _key. Drops all plans if there are too many.
+	void insert(Key _key, ShufflePlan _plan);
+
+	size_t size() const { return m_plans.size(); }
+
+private:
+	/// Bounds the memory used by long-running processes, e.g. the language server.
+	static size_t constexpr maxPlans = 1u << 16;
+
+	static void computeKey(
+		Stack const& _source,
+		Stack const& _target,
+		Key& _key,
+		std::vector<StackSlot const*>& _distinctSlots
+	);
+
+	std::map<Key, std::shared_ptr<ShufflePlan const>> m_plans;
+	/// Buffers reused by find() to avoid allocations on hits.
+	Key m_lookupKey;
+	std::vector<StackSlot const*> m_distinctSlots;
+};
+
+}
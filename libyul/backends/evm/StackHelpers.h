@@ -19,6 +19,7 @@
 #pragma once
 
 #include <libyul/backends/evm/ControlFlowGraph.h>
+#include <libyul/backends/evm/ShufflePlanCache.h>
 #include <libyul/Exceptions.h>
 
 #include <libsolutil/Visitor.h>
@@ -429,6 +430,7 @@ private:
 /// @a _pushOrDup is a function with signature void(StackSlot const&) that is called to push or dup the slot given as
 /// its argument to the stack top.
 /// @a _pop is a function with signature void() that is called when the top most slot is popped.
+/// The operations are looked up in the ShufflePlanCache if the same pattern of stacks was shuffled before.
 template<typename Swap, typename PushOrDup, typename Pop>
 void createStackLayout(Stack& _currentStack, Stack const& _targetStack, Swap _swap, PushOrDup _pushOrDup, Pop _pop)
 {
@@ -439,19 +441,22 @@ void createStackLayout(Stack& _currentStack, Stack const& _targetStack, Swap _sw
 		Swap swapCallback;
 		PushOrDup pushOrDupCallback;
 		Pop popCallback;
+		ShufflePlan& plan;
 		Multiplicity multiplicity;
 		ShuffleOperations(
 			Stack& _currentStack,
 			Stack const& _targetStack,
 			Swap _swap,
 			PushOrDup _pushOrDup,
-			Pop _pop
+			Pop _pop,
+			ShufflePlan& _plan
 		):
 			currentStack(_currentStack),
 			targetStack(_targetStack),
 			swapCallback(_swap),
 			pushOrDupCallback(_pushOrDup),
-			popCallback(_pop)
+			popCallback(_pop),
+			plan(_plan)
 		{
 			for (auto const& slot: currentStack)
 				--multiplicity[slot];
@@ -480,6 +485,7 @@ void createStackLayout(Stack& _currentStack, Stack const& _targetStack, Swap _sw
 		}
 		void swap(size_t _i)
 		{
+			plan.push_back({ShuffleOperation::Kind::Swap, _i});
 			swapCallback(static_cast<unsigned>(_i));
 			std::swap(currentStack.at(currentStack.size() - _i - 1), currentStack.back());
 		}
@@ -487,18 +493,46 @@ void createStackLayout(Stack& _currentStack, Stack const& _targetStack, Swap _sw
 		size_t targetSize() { return targetStack.size(); }
 		void pop()
 		{
+			plan.push_back({ShuffleOperation::Kind::Pop, 0});
 			popCallback();
 			currentStack.pop_back();
 		}
 		void pushOrDupTarget(size_t _offset)
 		{
+			plan.push_back({ShuffleOperation::Kind::PushOrDup, _offset});
 			auto const& targetSlot = targetStack.at(_offset);
 			pushOrDupCallback(targetSlot);
 			currentStack.push_back(targetSlot);
 		}
 	};
 
-	Shuffler<ShuffleOperations>::shuffle(_currentStack, _targetStack, _swap, _pushOrDup, _pop);
+	ShufflePlanCache& cache = ShufflePlanCache::instance();
+	if (std::shared_ptr<ShufflePlan const> plan = cache.find(_currentStack, _targetStack))
+		// Replays the operations exactly as the shuffler would perform them.
+		for (ShuffleOperation const& operation: *plan)
+			switch (operation.kind)
+			{
+			case ShuffleOperation::Kind::Swap:
+				_swap(static_cast<unsigned>(operation.argument));
+				std::swap(_currentStack.at(_currentStack.size() - operation.argument - 1), _currentStack.back());
+				break;
+			case ShuffleOperation::Kind::PushOrDup:
+				_pushOrDup(_targetStack.at(operation.argument));
+				_currentStack.push_back(_targetStack.at(operation.argument));
+				break;
+			case ShuffleOperation::Kind::Pop:
+				_pop();
+				_currentStack.pop_back();
+				break;
+			}
+	else
+	{
+		// Copied, since the shuffling operations might look up other plans.
+		ShufflePlanCache::Key key = cache.lastKey();
+		ShufflePlan newPlan;
+		Shuffler<ShuffleOperations>::shuffle(_currentStack, _targetStack, _swap, _pushOrDup, _pop, newPlan);
+		cache.insert(std::move(key), std::move(newPlan));
+	}
 
 	yulAssert(_currentStack.size() == _targetStack.size(), "");
 	for (auto&& [current, target]: ranges::zip_view(_currentStack, _targetStack))
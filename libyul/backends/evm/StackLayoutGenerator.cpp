@@ -44,31 +44,33 @@
 #include <range/v3/view/take_last.hpp>
 #include <range/v3/view/transform.hpp>
 
+#include <limits>
+
 using namespace solidity;
 using namespace solidity::yul;
 
-StackLayout StackLayoutGenerator::run(CFG const& _cfg)
+StackLayout StackLayoutGenerator::run(CFG const& _cfg, size_t _searchEffort)
 {
 	StackLayout stackLayout;
-	StackLayoutGenerator{stackLayout, nullptr}.processEntryPoint(*_cfg.entry);
+	StackLayoutGenerator{stackLayout, nullptr, _searchEffort}.processEntryPoint(*_cfg.entry);
 
 	for (auto& functionInfo: _cfg.functionInfo | ranges::views::values)
-		StackLayoutGenerator{stackLayout, &functionInfo}.processEntryPoint(*functionInfo.entry, &functionInfo);
+		StackLayoutGenerator{stackLayout, &functionInfo, _searchEffort}.processEntryPoint(*functionInfo.entry, &functionInfo);
 
 	return stackLayout;
 }
 
-std::map<YulString, std::vector<StackLayoutGenerator::StackTooDeep>> StackLayoutGenerator::reportStackTooDeep(CFG const& _cfg)
+std::map<YulString, std::vector<StackLayoutGenerator::StackTooDeep>> StackLayoutGenerator::reportStackTooDeep(CFG const& _cfg, size_t _searchEffort)
 {
 	std::map<YulString, std::vector<StackLayoutGenerator::StackTooDeep>> stackTooDeepErrors;
-	stackTooDeepErrors[YulString{}] = reportStackTooDeep(_cfg, YulString{});
+	stackTooDeepErrors[YulString{}] = reportStackTooDeep(_cfg, YulString{}, _searchEffort);
 	for (auto const& function: _cfg.functions)
-		if (auto errors = reportStackTooDeep(_cfg, function->name); !errors.empty())
+		if (auto errors = reportStackTooDeep(_cfg, function->name, _searchEffort); !errors.empty())
 			stackTooDeepErrors[function->name] = std::move(errors);
 	return stackTooDeepErrors;
 }
 
-std::vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStackTooDeep(CFG const& _cfg, YulString _functionName)
+std::vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStackTooDeep(CFG const& _cfg, YulString _functionName, size_t _searchEffort)
 {
 	StackLayout stackLayout;
 	CFG::FunctionInfo const* functionInfo = nullptr;
@@ -82,15 +84,20 @@ std::vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStac
 		yulAssert(functionInfo, "Function not found.");
 	}
 
-	StackLayoutGenerator generator{stackLayout, functionInfo};
+	StackLayoutGenerator generator{stackLayout, functionInfo, _searchEffort};
 	CFG::BasicBlock const* entry = functionInfo ? functionInfo->entry : _cfg.entry;
 	generator.processEntryPoint(*entry);
 	return generator.reportStackTooDeep(*entry);
 }
 
-StackLayoutGenerator::StackLayoutGenerator(StackLayout& _layout, CFG::FunctionInfo const* _functionInfo):
+StackLayoutGenerator::StackLayoutGenerator(
+	StackLayout& _layout,
+	CFG::FunctionInfo const* _functionInfo,
+	size_t _searchEffort
+):
 	m_layout(_layout),
-	m_currentFunctionInfo(_functionInfo)
+	m_currentFunctionInfo(_functionInfo),
+	m_searchEffort(_searchEffort)
 {
 }
 
@@ -545,11 +552,11 @@ void StackLayoutGenerator::stitchConditionalJumps(CFG::BasicBlock const& _block)
 	});
 }
 
-Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _stack2)
+Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _stack2) const
 {
 	// TODO: it would be nicer to replace this by a constructive algorithm.
 	// Currently it uses a reduced version of the Heap Algorithm to partly brute-force, which seems
-	// to work decently well.
+	// to work decently well. With a search effort, its result is improved further by a local search.
 
 	Stack commonPrefix;
 	for (auto&& [slot1, slot2]: ranges::zip_view(_stack1, _stack2))
@@ -578,7 +585,9 @@ Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _sta
 		return std::holds_alternative<LiteralSlot>(slot) || std::holds_alternative<FunctionCallReturnLabelSlot>(slot);
 	});
 
-	auto evaluate = [&](Stack const& _candidate) -> size_t {
+	// Candidates are only of interest if they are cheaper than @a _bound. If shuffling to the first
+	// stack already costs at least that much, the shuffling to the second one is not simulated.
+	auto evaluate = [&](Stack const& _candidate, size_t _bound) -> size_t {
 		size_t numOps = 0;
 		Stack testStack = _candidate;
 		auto swap = [&](unsigned _swapDepth) { ++numOps; if (_swapDepth > 16) numOps += 1000; };
@@ -591,6 +600,8 @@ Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _sta
 				numOps += 1000;
 		};
 		createStackLayout(testStack, stack1Tail, swap, dupOrPush, [&](){});
+		if (numOps >= _bound)
+			return numOps;
 		testStack = _candidate;
 		createStackLayout(testStack, stack2Tail, swap, dupOrPush, [&](){});
 		return numOps;
@@ -599,7 +610,7 @@ Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _sta
 	// See https://en.wikipedia.org/wiki/Heap's_algorithm
 	size_t n = candidate.size();
 	Stack bestCandidate = candidate;
-	size_t bestCost = evaluate(candidate);
+	size_t bestCost = evaluate(candidate, std::numeric_limits<size_t>::max());
 	std::vector<size_t> c(n, 0);
 	size_t i = 1;
 	while (i < n)
@@ -610,7 +621,7 @@ Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _sta
 				std::swap(candidate.front(), candidate[i]);
 			else
 				std::swap(candidate[c[i]], candidate[i]);
-			size_t cost = evaluate(candidate);
+			size_t cost = evaluate(candidate, bestCost);
 			if (cost < bestCost)
 			{
 				bestCost = cost;
@@ -629,6 +640,30 @@ Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _sta
 		}
 	}
 
+	// Steepest descent on transpositions: Every round moves to the cheapest candidate that differs from
+	// the current one by swapping two slots and stops as soon as no such candidate is cheaper.
+	for (size_t round = 0; round < m_searchEffort && bestCost > 0; ++round)
+	{
+		Stack roundBestCandidate = bestCandidate;
+		size_t roundBestCost = bestCost;
+		for (size_t i = 0; i < n; ++i)
+			for (size_t j = i + 1; j < n; ++j)
+			{
+				candidate = bestCandidate;
+				std::swap(candidate[i], candidate[j]);
+				size_t cost = evaluate(candidate, roundBestCost);
+				if (cost < roundBestCost)
+				{
+					roundBestCost = cost;
+					roundBestCandidate = candidate;
+				}
+			}
+		if (roundBestCost == bestCost)
+			break;
+		bestCost = roundBestCost;
+		bestCandidate = std::move(roundBestCandidate);
+	}
+
 	return commonPrefix + bestCandidate;
 }
 
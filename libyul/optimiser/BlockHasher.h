@@ -139,6 +139,38 @@ public:
 	void operator()(FunctionCall const& _funCall) override;
 };
 
+/**
+ * Computes a hash of a block including all names, function definitions and nested blocks.
+ * In contrast to the BlockHasher, any change to the code, including renaming a variable,
+ * likely changes the hash. The optimiser suite uses it to find functions that were already
+ * transformed by a step before.
+ */
+class ASTHasher: public ASTWalker, public ASTHasherBase
+{
+public:
+	static uint64_t run(Block const& _block);
+
+	using ASTWalker::operator();
+
+	void operator()(Literal const&) override;
+	void operator()(Identifier const&) override;
+	void operator()(FunctionCall const& _funCall) override;
+	void operator()(ExpressionStatement const& _statement) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(VariableDeclaration const& _varDecl) override;
+	void operator()(If const& _if) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const&) override;
+	void operator()(ForLoop const&) override;
+	void operator()(Break const&) override;
+	void operator()(Continue const&) override;
+	void operator()(Leave const&) override;
+	void operator()(Block const& _block) override;
+
+private:
+	void hashTypedNames(std::vector<TypedName> const& _names);
+};
+
 struct ExpressionHash
 {
 	uint64_t operator()(Expression const& _expression) const
@@ -21,8 +21,6 @@
 
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 
-#include <libyul/optimiser/SyntacticalEquality.h>
-#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/SideEffects.h>
@@ -31,22 +29,28 @@
 #include <libyul/Dialect.h>
 #include <libyul/Utilities.h>
 
+#include <libsolutil/Visitor.h>
+
 using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
-void CommonSubexpressionEliminator::run(OptimiserStepContext& _context, Block& _ast)
+FunctionLocalTransform CommonSubexpressionEliminator::functionLocalTransform(
+	OptimiserStepContext& _context,
+	Block const& _ast
+)
 {
-	CommonSubexpressionEliminator cse{
-		_context.dialect,
+	auto functionSideEffects = std::make_shared<std::map<YulString, SideEffects> const>(
 		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+	);
+	return [&dialect = _context.dialect, functionSideEffects](Statement& _statement) {
+		CommonSubexpressionEliminator{dialect, functionSideEffects}.visit(_statement);
 	};
-	cse(_ast);
 }
 
 CommonSubexpressionEliminator::CommonSubexpressionEliminator(
 	Dialect const& _dialect,
-	std::map<YulString, SideEffects> _functionSideEffects
+	std::shared_ptr<std::map<YulString, SideEffects> const> _functionSideEffects
 ):
 	DataFlowAnalyzer(_dialect, MemoryAndStorage::Ignore, std::move(_functionSideEffects))
 {
@@ -56,6 +60,12 @@ void CommonSubexpressionEliminator::operator()(FunctionDefinition& _fun)
 {
 	ScopedSaveAndRestore returnVariables(m_returnVariables, {});
 	ScopedSaveAndRestore replacementCandidates(m_replacementCandidates, {});
+	// The numbers are only compared within a function, so the tables do not grow with the
+	// whole program. New numbers stay distinct from the ones of the enclosing code.
+	ScopedSaveAndRestore variableValueNumbers(m_variableValueNumbers, {});
+	ScopedSaveAndRestore identifierNumbers(m_identifierNumbers, {});
+	ScopedSaveAndRestore literalNumbers(m_literalNumbers, {});
+	ScopedSaveAndRestore functionCallNumbers(m_functionCallNumbers, {});
 
 	for (auto const& v: _fun.returnVariables)
 		m_returnVariables.insert(v.name);
@@ -65,14 +75,19 @@ void CommonSubexpressionEliminator::operator()(FunctionDefinition& _fun)
 
 void CommonSubexpressionEliminator::visit(Expression& _e)
 {
+	bool const isArgument = m_visitingExpression;
+	ScopedSaveAndRestore visitingExpression(m_visitingExpression, true);
+	size_t const argumentNumbersBegin = m_argumentNumbers.size();
+
 	bool descend = true;
+	BuiltinFunction const* builtin = nullptr;
 	// If this is a function call to a function that requires literal arguments,
 	// do not try to simplify there.
 	if (std::holds_alternative<FunctionCall>(_e))
 	{
 		FunctionCall& funCall = std::get<FunctionCall>(_e);
 
-		if (BuiltinFunction const* builtin = m_dialect.builtin(funCall.functionName.name))
+		if ((builtin = m_dialect.builtin(funCall.functionName.name)))
 		{
 			for (size_t i = funCall.arguments.size(); i > 0; i--)
 				// We should not modify function arguments that have to be literals
@@ -93,6 +108,7 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 	if (descend)
 		DataFlowAnalyzer::visit(_e);
 
+	ValueNumber number = 0;
 	if (Identifier const* identifier = std::get_if<Identifier>(&_e))
 	{
 		YulString identifierName = identifier->name;
@@ -103,32 +119,113 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 				if (inScope(value->name))
 					_e = Identifier{debugDataOf(_e), value->name};
 		}
+		number = valueNumber(std::get<Identifier>(_e).name);
 	}
-	else if (auto const* candidates = util::valueOrNullptr(m_replacementCandidates, _e))
-		for (auto const& variable: *candidates)
-			if (AssignedValue const* value = variableValue(variable))
-			{
-				assertThrow(value->value, OptimizerException, "");
-				// Prevent using the default value of return variables
-				// instead of literal zeros.
-				if (
-					m_returnVariables.count(variable) &&
-					std::holds_alternative<Literal>(*value->value) &&
-					std::get<Literal>(*value->value).value.value() == 0
-				)
-					continue;
-				// We check for syntactic equality again because the value might have changed.
-				if (inScope(variable) && SyntacticallyEqual{}(_e, *value->value))
+	else
+	{
+		if (FunctionCall const* funCall = std::get_if<FunctionCall>(&_e))
+		{
+			// The numbers of the visited arguments are on the stack in the order they were visited,
+			// i.e. in reverse. Literal arguments of builtins are not visited.
+			std::vector<ValueNumber> arguments(funCall->arguments.size());
+			size_t next = m_argumentNumbers.size();
+			for (size_t i = 0; i < arguments.size(); ++i)
+				if (builtin && builtin->literalArgument(i))
+					arguments[i] = valueNumber(funCall->arguments[i]);
+				else
+				{
+					yulAssert(next > argumentNumbersBegin);
+					arguments[i] = m_argumentNumbers[--next];
+				}
+			yulAssert(next == argumentNumbersBegin);
+			number = valueNumber(funCall->functionName.name, std::move(arguments));
+		}
+		else
+			number = valueNumber(std::get<Literal>(_e));
+
+		if (auto const* candidates = util::valueOrNullptr(m_replacementCandidates, number))
+			for (auto const& variable: *candidates)
+				if (AssignedValue const* value = variableValue(variable))
 				{
-					_e = Identifier{debugDataOf(_e), variable};
-					break;
+					assertThrow(value->value, OptimizerException, "");
+					// Prevent using the default value of return variables
+					// instead of literal zeros.
+					if (
+						m_returnVariables.count(variable) &&
+						std::holds_alternative<Literal>(*value->value) &&
+						std::get<Literal>(*value->value).value.value() == 0
+					)
+						continue;
+					// We check the value number again because the variable might have been re-assigned.
+					if (inScope(variable) && m_variableValueNumbers.at(variable) == number)
+					{
+						_e = Identifier{debugDataOf(_e), variable};
+						number = valueNumber(variable);
+						break;
+					}
 				}
-			}
+	}
+
+	m_argumentNumbers.resize(argumentNumbersBegin);
+	if (isArgument)
+		m_argumentNumbers.push_back(number);
+	else
+	{
+		m_lastVisitedExpression = &_e;
+		m_lastVisitedNumber = number;
+	}
 }
 
 void CommonSubexpressionEliminator::assignValue(YulString _variable, Expression const* _value)
 {
 	if (_value)
-		m_replacementCandidates[*_value].insert(_variable);
+	{
+		// The value of a declaration or assignment has just been visited. Other values, i.e. the
+		// zero of declarations without value, are numbered here.
+		ValueNumber number = (_value == m_lastVisitedExpression) ? m_lastVisitedNumber : valueNumber(*_value);
+		m_replacementCandidates[number].insert(_variable);
+		m_variableValueNumbers[_variable] = number;
+	}
 	DataFlowAnalyzer::assignValue(_variable, _value);
 }
+
+CommonSubexpressionEliminator::ValueNumber CommonSubexpressionEliminator::valueNumber(Expression const& _expression)
+{
+	return std::visit(GenericVisitor{
+		[&](Literal const& _literal) { return valueNumber(_literal); },
+		[&](Identifier const& _identifier) { return valueNumber(_identifier.name); },
+		[&](FunctionCall const& _funCall) {
+			std::vector<ValueNumber> arguments;
+			for (Expression const& argument: _funCall.arguments)
+				arguments.emplace_back(valueNumber(argument));
+			return valueNumber(_funCall.functionName.name, std::move(arguments));
+		}
+	}, _expression);
+}
+
+CommonSubexpressionEliminator::ValueNumber CommonSubexpressionEliminator::valueNumber(Literal const& _literal)
+{
+	auto [it, inserted] = m_literalNumbers.try_emplace({_literal.type, _literal.value}, m_nextValueNumber);
+	if (inserted)
+		++m_nextValueNumber;
+	return it->second;
+}
+
+CommonSubexpressionEliminator::ValueNumber CommonSubexpressionEliminator::valueNumber(YulString _identifier)
+{
+	auto [it, inserted] = m_identifierNumbers.try_emplace(_identifier, m_nextValueNumber);
+	if (inserted)
+		++m_nextValueNumber;
+	return it->second;
+}
+
+CommonSubexpressionEliminator::ValueNumber CommonSubexpressionEliminator::valueNumber(
+	YulString _functionName,
+	std::vector<ValueNumber> _arguments
+)
+{
+	auto [it, inserted] = m_functionCallNumbers.try_emplace({_functionName, std::move(_arguments)}, m_nextValueNumber);
+	if (inserted)
+		++m_nextValueNumber;
+	return it->second;
+}
@@ -24,10 +24,12 @@
 
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 #include <libyul/optimiser/OptimiserStep.h>
-#include <libyul/optimiser/SyntacticalEquality.h>
-#include <libyul/optimiser/BlockHasher.h>
 
+#include <map>
 #include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -39,13 +41,17 @@ struct SideEffects;
  * Optimisation stage that replaces expressions known to be the current value of a variable
  * in scope by a reference to that variable.
  *
+ * Syntactically equal expressions are identified by value numbers that are assigned bottom-up
+ * while visiting, so every expression is looked up in constant time from the numbers of its
+ * arguments instead of being hashed and compared in full.
+ *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
-class CommonSubexpressionEliminator: public DataFlowAnalyzer
+class CommonSubexpressionEliminator: public DataFlowAnalyzer, public FunctionLocalStep<CommonSubexpressionEliminator>
 {
 public:
 	static constexpr char const* name{"CommonSubexpressionEliminator"};
-	static void run(OptimiserStepContext&, Block& _ast);
+	static FunctionLocalTransform functionLocalTransform(OptimiserStepContext&, Block const& _ast);
 
 	using DataFlowAnalyzer::operator();
 	void operator()(FunctionDefinition&) override;
@@ -53,7 +59,7 @@ public:
 private:
 	CommonSubexpressionEliminator(
 		Dialect const& _dialect,
-		std::map<YulString, SideEffects> _functionSideEffects
+		std::shared_ptr<std::map<YulString, SideEffects> const> _functionSideEffects
 	);
 
 protected:
@@ -62,13 +68,32 @@ protected:
 
 	void assignValue(YulString _variable, Expression const* _value) override;
 private:
+	/// Number that is the same for two expressions if and only if they are syntactically equal.
+	using ValueNumber = size_t;
+
+	ValueNumber valueNumber(Expression const& _expression);
+	ValueNumber valueNumber(Literal const& _literal);
+	ValueNumber valueNumber(YulString _identifier);
+	ValueNumber valueNumber(YulString _functionName, std::vector<ValueNumber> _arguments);
+
 	std::set<YulString> m_returnVariables;
-	std::unordered_map<
-		std::reference_wrapper<Expression const>,
-		std::set<YulString>,
-		ExpressionHash,
-		SyntacticallyEqualExpression
-	> m_replacementCandidates;
+	/// Variables by the value number of the value they were assigned.
+	std::unordered_map<ValueNumber, std::set<YulString>> m_replacementCandidates;
+	/// Value number of the value most recently assigned to each variable.
+	std::unordered_map<YulString, ValueNumber> m_variableValueNumbers;
+
+	std::unordered_map<YulString, ValueNumber> m_identifierNumbers;
+	std::map<std::pair<YulString, LiteralValue>, ValueNumber> m_literalNumbers;
+	std::map<std::pair<YulString, std::vector<ValueNumber>>, ValueNumber> m_functionCallNumbers;
+	ValueNumber m_nextValueNumber = 0;
+
+	/// Value numbers of the visited arguments of the function calls currently being visited.
+	std::vector<ValueNumber> m_argumentNumbers;
+	/// True while visiting an expression, i.e. if the expression being visited is an argument.
+	bool m_visitingExpression = false;
+	/// The most recently visited expression that is not an argument and its value number.
+	Expression const* m_lastVisitedExpression = nullptr;
+	ValueNumber m_lastVisitedNumber = 0;
 };
 
 
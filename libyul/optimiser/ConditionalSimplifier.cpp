@@ -26,12 +26,14 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
-void ConditionalSimplifier::run(OptimiserStepContext& _context, Block& _ast)
+FunctionLocalTransform ConditionalSimplifier::functionLocalTransform(OptimiserStepContext& _context, Block const& _ast)
 {
-	ConditionalSimplifier{
-		_context.dialect,
+	auto functionSideEffects = std::make_shared<std::map<YulString, ControlFlowSideEffects> const>(
 		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
-	}(_ast);
+	);
+	return [&dialect = _context.dialect, functionSideEffects](Statement& _statement) {
+		ConditionalSimplifier{dialect, *functionSideEffects}.visit(_statement);
+	};
 }
 
 void ConditionalSimplifier::operator()(Switch& _switch)
@@ -49,11 +49,11 @@ namespace solidity::yul
  *
  * Prerequisite: Disambiguator.
  */
-class ConditionalSimplifier: public ASTModifier
+class ConditionalSimplifier: public ASTModifier, public FunctionLocalStep<ConditionalSimplifier>
 {
 public:
 	static constexpr char const* name{"ConditionalSimplifier"};
-	static void run(OptimiserStepContext& _context, Block& _ast);
+	static FunctionLocalTransform functionLocalTransform(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(Switch& _switch) override;
@@ -62,12 +62,12 @@ public:
 private:
 	explicit ConditionalSimplifier(
 		Dialect const& _dialect,
-		std::map<YulString, ControlFlowSideEffects> _sideEffects
+		std::map<YulString, ControlFlowSideEffects> const& _sideEffects
 	):
-		m_dialect(_dialect), m_functionSideEffects(std::move(_sideEffects))
+		m_dialect(_dialect), m_functionSideEffects(_sideEffects)
 	{}
 	Dialect const& m_dialect;
-	std::map<YulString, ControlFlowSideEffects> m_functionSideEffects;
+	std::map<YulString, ControlFlowSideEffects> const& m_functionSideEffects;
 };
 
 }
@@ -27,12 +27,14 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
-void ConditionalUnsimplifier::run(OptimiserStepContext& _context, Block& _ast)
+FunctionLocalTransform ConditionalUnsimplifier::functionLocalTransform(OptimiserStepContext& _context, Block const& _ast)
 {
-	ConditionalUnsimplifier{
-		_context.dialect,
+	auto functionSideEffects = std::make_shared<std::map<YulString, ControlFlowSideEffects> const>(
 		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
-	}(_ast);
+	);
+	return [&dialect = _context.dialect, functionSideEffects](Statement& _statement) {
+		ConditionalUnsimplifier{dialect, *functionSideEffects}.visit(_statement);
+	};
 }
 
 void ConditionalUnsimplifier::operator()(Switch& _switch)
@@ -29,11 +29,11 @@ namespace solidity::yul
  * Reverse of conditional simplifier.
  *
  */
-class ConditionalUnsimplifier: public ASTModifier
+class ConditionalUnsimplifier: public ASTModifier, public FunctionLocalStep<ConditionalUnsimplifier>
 {
 public:
 	static constexpr char const* name{"ConditionalUnsimplifier"};
-	static void run(OptimiserStepContext& _context, Block& _ast);
+	static FunctionLocalTransform functionLocalTransform(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(Switch& _switch) override;
@@ -70,10 +70,12 @@ void removeEmptyCasesFromSwitch(Switch& _switchStmt)
 
 }
 
-void ControlFlowSimplifier::run(OptimiserStepContext& _context, Block& _ast)
+FunctionLocalTransform ControlFlowSimplifier::functionLocalTransform(OptimiserStepContext& _context, Block const& _ast)
 {
-	TypeInfo typeInfo(_context.dialect, _ast);
-	ControlFlowSimplifier{_context.dialect, typeInfo}(_ast);
+	auto typeInfo = std::make_shared<TypeInfo const>(_context.dialect, _ast);
+	return [&dialect = _context.dialect, typeInfo](Statement& _statement) {
+		ControlFlowSimplifier{dialect, *typeInfo}.visit(_statement);
+	};
 }
 
 void ControlFlowSimplifier::operator()(Block& _block)
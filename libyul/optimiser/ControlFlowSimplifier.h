@@ -48,11 +48,11 @@ class TypeInfo;
  *
  * Important: Introduces EVM opcodes and thus can only be used on EVM code for now.
  */
-class ControlFlowSimplifier: public ASTModifier
+class ControlFlowSimplifier: public ASTModifier, public FunctionLocalStep<ControlFlowSimplifier>
 {
 public:
 	static constexpr char const* name{"ControlFlowSimplifier"};
-	static void run(OptimiserStepContext&, Block& _ast);
+	static FunctionLocalTransform functionLocalTransform(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(Break&) override { ++m_numBreakStatements; }
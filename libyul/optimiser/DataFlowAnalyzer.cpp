@@ -45,7 +45,7 @@ using namespace solidity::yul;
 DataFlowAnalyzer::DataFlowAnalyzer(
 	Dialect const& _dialect,
 	MemoryAndStorage _analyzeStores,
-	std::map<YulString, SideEffects> _functionSideEffects
+	std::shared_ptr<std::map<YulString, SideEffects> const> _functionSideEffects
 ):
 	m_dialect(_dialect),
 	m_functionSideEffects(std::move(_functionSideEffects)),
@@ -72,23 +72,23 @@ void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
 		if (auto vars = isSimpleStore(StoreLoadLocation::Storage, _statement))
 		{
 			ASTModifier::operator()(_statement);
-			cxx20::erase_if(m_state.environment.storage, mapTuple([&](auto&& key, auto&& value) {
+			cxx20::erase_if(environment().storage, mapTuple([&](auto&& key, auto&& value) {
 				return
 					!m_knowledgeBase.knownToBeDifferent(vars->first, key) &&
 					vars->second != value;
 			}));
-			m_state.environment.storage[vars->first] = vars->second;
+			environment().storage[vars->first] = vars->second;
 			return;
 		}
 		else if (auto vars = isSimpleStore(StoreLoadLocation::Memory, _statement))
 		{
 			ASTModifier::operator()(_statement);
-			cxx20::erase_if(m_state.environment.memory, mapTuple([&](auto&& key, auto&& /* value */) {
+			cxx20::erase_if(environment().memory, mapTuple([&](auto&& key, auto&& /* value */) {
 				return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, key);
 			}));
 			// TODO erase keccak knowledge, but in a more clever way
-			m_state.environment.keccak = {};
-			m_state.environment.memory[vars->first] = vars->second;
+			environment().keccak = {};
+			environment().memory[vars->first] = vars->second;
 			return;
 		}
 	}
@@ -126,7 +126,7 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 void DataFlowAnalyzer::operator()(If& _if)
 {
 	clearKnowledgeIfInvalidated(*_if.condition);
-	Environment preEnvironment = m_state.environment;
+	std::shared_ptr<Environment const> preEnvironment = m_state.environment;
 
 	ASTModifier::operator()(_if);
 	joinKnowledge(preEnvironment);
@@ -141,7 +141,7 @@ void DataFlowAnalyzer::operator()(Switch& _switch)
 	std::set<YulString> assignedVariables;
 	for (auto& _case: _switch.cases)
 	{
-		Environment preEnvironment = m_state.environment;
+		std::shared_ptr<Environment const> preEnvironment = m_state.environment;
 		(*this)(_case.body);
 		joinKnowledge(preEnvironment);
 
@@ -224,7 +224,7 @@ void DataFlowAnalyzer::operator()(Block& _block)
 
 std::optional<YulString> DataFlowAnalyzer::storageValue(YulString _key) const
 {
-	if (YulString const* value = valueOrNullptr(m_state.environment.storage, _key))
+	if (YulString const* value = valueOrNullptr(m_state.environment->storage, _key))
 		return *value;
 	else
 		return std::nullopt;
@@ -232,7 +232,7 @@ std::optional<YulString> DataFlowAnalyzer::storageValue(YulString _key) const
 
 std::optional<YulString> DataFlowAnalyzer::memoryValue(YulString _key) const
 {
-	if (YulString const* value = valueOrNullptr(m_state.environment.memory, _key))
+	if (YulString const* value = valueOrNullptr(m_state.environment->memory, _key))
 		return *value;
 	else
 		return std::nullopt;
@@ -240,7 +240,7 @@ std::optional<YulString> DataFlowAnalyzer::memoryValue(YulString _key) const
 
 std::optional<YulString> DataFlowAnalyzer::keccakValue(YulString _start, YulString _length) const
 {
-	if (YulString const* value = valueOrNullptr(m_state.environment.keccak, std::make_pair(_start, _length)))
+	if (YulString const* value = valueOrNullptr(m_state.environment->keccak, std::make_pair(_start, _length)))
 		return *value;
 	else
 		return std::nullopt;
@@ -251,7 +251,7 @@ void DataFlowAnalyzer::handleAssignment(std::set<YulString> const& _variables, E
 	if (!_isDeclaration)
 		clearValues(_variables);
 
-	MovableChecker movableChecker{m_dialect, &m_functionSideEffects};
+	MovableChecker movableChecker{m_dialect, m_functionSideEffects.get()};
 	if (_value)
 		movableChecker.visit(*_value);
 	else
@@ -270,20 +270,20 @@ void DataFlowAnalyzer::handleAssignment(std::set<YulString> const& _variables, E
 	auto const& referencedVariables = movableChecker.referencedVariables();
 	for (auto const& name: _variables)
 	{
-		m_state.references[name] = referencedVariables;
-		if (!_isDeclaration)
+		setReferences(name, referencedVariables);
+		if (!_isDeclaration && !environmentEmpty())
 		{
 			// assignment to slot denoted by "name"
-			m_state.environment.storage.erase(name);
+			environment().storage.erase(name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_state.environment.storage, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			cxx20::erase_if(environment().storage, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
 			// assignment to slot denoted by "name"
-			m_state.environment.memory.erase(name);
+			environment().memory.erase(name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_state.environment.keccak, [&name](auto&& _item) {
+			cxx20::erase_if(environment().keccak, [&name](auto&& _item) {
 				return _item.first.first == name || _item.first.second == name || _item.second == name;
 			});
-			cxx20::erase_if(m_state.environment.memory, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			cxx20::erase_if(environment().memory, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
 		}
 	}
 
@@ -296,11 +296,11 @@ void DataFlowAnalyzer::handleAssignment(std::set<YulString> const& _variables, E
 			// On the other hand, if we knew the value in the slot
 			// already, then the sload() / mload() would have been replaced by a variable anyway.
 			if (auto key = isSimpleLoad(StoreLoadLocation::Memory, *_value))
-				m_state.environment.memory[*key] = variable;
+				environment().memory[*key] = variable;
 			else if (auto key = isSimpleLoad(StoreLoadLocation::Storage, *_value))
-				m_state.environment.storage[*key] = variable;
+				environment().storage[*key] = variable;
 			else if (auto arguments = isKeccak(*_value))
-				m_state.environment.keccak[*arguments] = variable;
+				environment().keccak[*arguments] = variable;
 		}
 	}
 }
@@ -315,7 +315,7 @@ void DataFlowAnalyzer::popScope()
 	for (auto const& name: m_variableScopes.back().variables)
 	{
 		m_state.value.erase(name);
-		m_state.references.erase(name);
+		clearReferences(name);
 	}
 	m_variableScopes.pop_back();
 }
@@ -341,27 +341,29 @@ void DataFlowAnalyzer::clearValues(std::set<YulString> _variables)
 	auto eraseCondition = mapTuple([&_variables](auto&& key, auto&& value) {
 		return _variables.count(key) || _variables.count(value);
 	});
-	cxx20::erase_if(m_state.environment.storage, eraseCondition);
-	cxx20::erase_if(m_state.environment.memory, eraseCondition);
-	cxx20::erase_if(m_state.environment.keccak, [&_variables](auto&& _item) {
-		return
-			_variables.count(_item.first.first) ||
-			_variables.count(_item.first.second) ||
-			_variables.count(_item.second);
-	});
+	if (!environmentEmpty())
+	{
+		cxx20::erase_if(environment().storage, eraseCondition);
+		cxx20::erase_if(environment().memory, eraseCondition);
+		cxx20::erase_if(environment().keccak, [&_variables](auto&& _item) {
+			return
+				_variables.count(_item.first.first) ||
+				_variables.count(_item.first.second) ||
+				_variables.count(_item.second);
+		});
+	}
 
 	// Also clear variables that reference variables to be cleared.
 	std::set<YulString> referencingVariables;
 	for (auto const& variableToClear: _variables)
-		for (auto const& [ref, names]: m_state.references)
-			if (names.count(variableToClear))
-				referencingVariables.emplace(ref);
+		if (auto const* names = valueOrNullptr(m_state.referencedBy, variableToClear))
+			referencingVariables += *names;
 
 	// Clear the value and update the reference relation.
 	for (auto const& name: _variables + referencingVariables)
 	{
 		m_state.value.erase(name);
-		m_state.references.erase(name);
+		clearReferences(name);
 	}
 }
 
@@ -370,17 +372,56 @@ void DataFlowAnalyzer::assignValue(YulString _variable, Expression const* _value
 	m_state.value[_variable] = {_value, m_loopDepth};
 }
 
+DataFlowAnalyzer::Environment& DataFlowAnalyzer::environment()
+{
+	if (m_state.environment.use_count() > 1)
+		m_state.environment = std::make_shared<Environment>(*m_state.environment);
+	return *m_state.environment;
+}
+
+bool DataFlowAnalyzer::environmentEmpty() const
+{
+	return
+		m_state.environment->storage.empty() &&
+		m_state.environment->memory.empty() &&
+		m_state.environment->keccak.empty();
+}
+
+void DataFlowAnalyzer::setReferences(YulString _variable, std::set<YulString> const& _references)
+{
+	clearReferences(_variable);
+	for (YulString reference: _references)
+		m_state.referencedBy[reference].emplace(_variable);
+	m_state.references[_variable] = _references;
+}
+
+void DataFlowAnalyzer::clearReferences(YulString _variable)
+{
+	auto it = m_state.references.find(_variable);
+	if (it == m_state.references.end())
+		return;
+	for (YulString reference: it->second)
+	{
+		auto referencedBy = m_state.referencedBy.find(reference);
+		yulAssert(referencedBy != m_state.referencedBy.end());
+		referencedBy->second.erase(_variable);
+		if (referencedBy->second.empty())
+			m_state.referencedBy.erase(referencedBy);
+	}
+	m_state.references.erase(it);
+}
+
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
 {
 	if (!m_analyzeStores)
 		return;
-	SideEffectsCollector sideEffects(m_dialect, _block, &m_functionSideEffects);
-	if (sideEffects.invalidatesStorage())
-		m_state.environment.storage.clear();
-	if (sideEffects.invalidatesMemory())
+	SideEffectsCollector sideEffects(m_dialect, _block, m_functionSideEffects.get());
+	if (sideEffects.invalidatesStorage() && !m_state.environment->storage.empty())
+		environment().storage.clear();
+	if (sideEffects.invalidatesMemory() && (!m_state.environment->memory.empty() || !m_state.environment->keccak.empty()))
 	{
-		m_state.environment.memory.clear();
-		m_state.environment.keccak.clear();
+		environment().memory.clear();
+		environment().keccak.clear();
 	}
 }
 
@@ -388,13 +429,13 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 {
 	if (!m_analyzeStores)
 		return;
-	SideEffectsCollector sideEffects(m_dialect, _expr, &m_functionSideEffects);
-	if (sideEffects.invalidatesStorage())
-		m_state.environment.storage.clear();
-	if (sideEffects.invalidatesMemory())
+	SideEffectsCollector sideEffects(m_dialect, _expr, m_functionSideEffects.get());
+	if (sideEffects.invalidatesStorage() && !m_state.environment->storage.empty())
+		environment().storage.clear();
+	if (sideEffects.invalidatesMemory() && (!m_state.environment->memory.empty() || !m_state.environment->keccak.empty()))
 	{
-		m_state.environment.memory.clear();
-		m_state.environment.keccak.clear();
+		environment().memory.clear();
+		environment().keccak.clear();
 	}
 }
 
@@ -453,14 +494,16 @@ std::optional<std::pair<YulString, YulString>> DataFlowAnalyzer::isKeccak(Expres
 	return std::nullopt;
 }
 
-void DataFlowAnalyzer::joinKnowledge(Environment const& _olderEnvironment)
+void DataFlowAnalyzer::joinKnowledge(std::shared_ptr<Environment const> const& _olderEnvironment)
 {
-	if (!m_analyzeStores)
+	// Nothing to do if the knowledge was not modified since the older point.
+	if (!m_analyzeStores || m_state.environment == _olderEnvironment)
 		return;
-	joinKnowledgeHelper(m_state.environment.storage, _olderEnvironment.storage);
-	joinKnowledgeHelper(m_state.environment.memory, _olderEnvironment.memory);
-	cxx20::erase_if(m_state.environment.keccak, mapTuple([&_olderEnvironment](auto&& key, auto&& currentValue) {
-		YulString const* oldValue = valueOrNullptr(_olderEnvironment.keccak, key);
+	Environment& currentEnvironment = environment();
+	joinKnowledgeHelper(currentEnvironment.storage, _olderEnvironment->storage);
+	joinKnowledgeHelper(currentEnvironment.memory, _olderEnvironment->memory);
+	cxx20::erase_if(currentEnvironment.keccak, mapTuple([&_olderEnvironment](auto&& key, auto&& currentValue) {
+		YulString const* oldValue = valueOrNullptr(_olderEnvironment->keccak, key);
 		return !oldValue || *oldValue != currentValue;
 	}));
 }
@@ -472,8 +515,8 @@ void DataFlowAnalyzer::joinKnowledgeHelper(
 {
 	// We clear if the key does not exist in the older map or if the value is different.
 	// This also works for memory because _older is an "older version"
-	// of m_state.environment.memory and thus any overlapping write would have cleared the keys
-	// that are not known to be different inside m_state.environment.memory already.
+	// of m_state.environment->memory and thus any overlapping write would have cleared the keys
+	// that are not known to be different inside m_state.environment->memory already.
 	cxx20::erase_if(_this, mapTuple([&_older](auto&& key, auto&& currentValue){
 		YulString const* oldValue = valueOrNullptr(_older, key);
 		return !oldValue || *oldValue != currentValue;
@@ -33,7 +33,10 @@
 #include <libsolutil/Common.h>
 
 #include <map>
+#include <memory>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace solidity::yul
 {
@@ -68,6 +71,8 @@ struct AssignedValue
  *
  * For forward-joining control flow, storage/memory information from the branches is combined.
  * If the keys or values are different or non-existent in one branch, the key is deleted.
+ * The information is shared with the state before the branch until it is first modified,
+ * so that branches that do not touch storage or memory are neither copied nor joined.
  * This works also for memory (where addresses overlap) because one branch is always an
  * older version of the other and thus overlapping contents would have been deleted already
  * at the point of assignment.
@@ -89,7 +94,7 @@ public:
 	explicit DataFlowAnalyzer(
 		Dialect const& _dialect,
 		MemoryAndStorage _analyzeStores,
-		std::map<YulString, SideEffects> _functionSideEffects = {}
+		std::shared_ptr<std::map<YulString, SideEffects> const> _functionSideEffects = {}
 	);
 
 	using ASTModifier::operator();
@@ -105,7 +110,6 @@ public:
 	/// @returns the current value of the given variable, if known - always movable.
 	AssignedValue const* variableValue(YulString _variable) const { return util::valueOrNullptr(m_state.value, _variable); }
 	std::set<YulString> const* references(YulString _variable) const { return util::valueOrNullptr(m_state.references, _variable); }
-	std::map<YulString, AssignedValue> const& allValues() const { return m_state.value; }
 	std::optional<YulString> storageValue(YulString _key) const;
 	std::optional<YulString> memoryValue(YulString _key) const;
 	std::optional<YulString> keccakValue(YulString _start, YulString _length) const;
@@ -165,7 +169,8 @@ protected:
 	Dialect const& m_dialect;
 	/// Side-effects of user-defined functions. Worst-case side-effects are assumed
 	/// if this is not provided or the function is not found.
-	std::map<YulString, SideEffects> m_functionSideEffects;
+	/// Shared, so that instances running concurrently on different functions can use the same map.
+	std::shared_ptr<std::map<YulString, SideEffects> const> m_functionSideEffects;
 
 private:
 	struct Environment
@@ -178,18 +183,33 @@ private:
 	struct State
 	{
 		/// Current values of variables, always movable.
-		std::map<YulString, AssignedValue> value;
+		std::unordered_map<YulString, AssignedValue> value;
 		/// m_references[a].contains(b) <=> the current expression assigned to a references b
 		std::unordered_map<YulString, std::set<YulString>> references;
+		/// Inverse of references: referencedBy[b].contains(a) <=> references[a].contains(b)
+		std::unordered_map<YulString, std::unordered_set<YulString>> referencedBy;
 
-		Environment environment;
+		/// Possibly shared with snapshots taken at control-flow splits, use environment()
+		/// for modifications.
+		std::shared_ptr<Environment> environment = std::make_shared<Environment>();
 	};
 
+	/// @returns the storage and memory knowledge for modification, copying it first
+	/// if it is shared with a snapshot.
+	Environment& environment();
+	/// @returns true if nothing is known about storage and memory.
+	bool environmentEmpty() const;
+
+	/// Sets the variables referenced by the current value of @a _variable.
+	void setReferences(YulString _variable, std::set<YulString> const& _references);
+	/// Removes the variables referenced by the current value of @a _variable.
+	void clearReferences(YulString _variable);
+
 	/// Joins knowledge about storage and memory with an older point in the control-flow.
 	/// This only works if the current state is a direct successor of the older point,
 	/// i.e. `_olderState.storage` and `_olderState.memory` cannot have additional changes.
 	/// Does nothing if memory and storage analysis is disabled / ignored.
-	void joinKnowledge(Environment const& _olderEnvironment);
+	void joinKnowledge(std::shared_ptr<Environment const> const& _olderEnvironment);
 
 	static void joinKnowledgeHelper(
 		std::unordered_map<YulString, YulString>& _thisData,
@@ -34,13 +34,14 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::yul;
 
-void DeadCodeEliminator::run(OptimiserStepContext& _context, Block& _ast)
+FunctionLocalTransform DeadCodeEliminator::functionLocalTransform(OptimiserStepContext& _context, Block const& _ast)
 {
-	ControlFlowSideEffectsCollector sideEffects(_context.dialect, _ast);
-	DeadCodeEliminator{
-		_context.dialect,
-		sideEffects.functionSideEffectsNamed()
-	}(_ast);
+	auto functionSideEffects = std::make_shared<std::map<YulString, ControlFlowSideEffects> const>(
+		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
+	);
+	return [&dialect = _context.dialect, functionSideEffects](Statement& _statement) {
+		DeadCodeEliminator{dialect, *functionSideEffects}.visit(_statement);
+	};
 }
 
 void DeadCodeEliminator::operator()(ForLoop& _for)
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/YulString.h>
 #include <libyul/ControlFlowSideEffects.h>
 
@@ -31,7 +32,6 @@
 namespace solidity::yul
 {
 struct Dialect;
-struct OptimiserStepContext;
 
 /**
  * Optimisation stage that removes unreachable code
@@ -49,11 +49,11 @@ struct OptimiserStepContext;
  *
  * Prerequisite: ForLoopInitRewriter, Function Hoister, Function Grouper
  */
-class DeadCodeEliminator: public ASTModifier
+class DeadCodeEliminator: public ASTModifier, public FunctionLocalStep<DeadCodeEliminator>
 {
 public:
 	static constexpr char const* name{"DeadCodeEliminator"};
-	static void run(OptimiserStepContext&, Block& _ast);
+	static FunctionLocalTransform functionLocalTransform(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(ForLoop& _for) override;
@@ -62,11 +62,11 @@ public:
 private:
 	DeadCodeEliminator(
 		Dialect const& _dialect,
-		std::map<YulString, ControlFlowSideEffects> _sideEffects
-	): m_dialect(_dialect), m_functionSideEffects(std::move(_sideEffects)) {}
+		std::map<YulString, ControlFlowSideEffects> const& _sideEffects
+	): m_dialect(_dialect), m_functionSideEffects(_sideEffects) {}
 
 	Dialect const& m_dialect;
-	std::map<YulString, ControlFlowSideEffects> m_functionSideEffects;
+	std::map<YulString, ControlFlowSideEffects> const& m_functionSideEffects;
 };
 
 }
@@ -33,16 +33,21 @@ using namespace solidity::util;
 using namespace solidity::evmasm;
 using namespace solidity::yul;
 
-void EqualStoreEliminator::run(OptimiserStepContext const& _context, Block& _ast)
+FunctionLocalTransform EqualStoreEliminator::functionLocalTransform(
+	OptimiserStepContext& _context,
+	Block const& _ast
+)
 {
-	EqualStoreEliminator eliminator{
-		_context.dialect,
+	auto functionSideEffects = std::make_shared<std::map<YulString, SideEffects> const>(
 		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
-	};
-	eliminator(_ast);
+	);
+	return [&dialect = _context.dialect, functionSideEffects](Statement& _statement) {
+		EqualStoreEliminator eliminator{dialect, functionSideEffects};
+		eliminator.visit(_statement);
 
-	StatementRemover remover{eliminator.m_pendingRemovals};
-	remover(_ast);
+		StatementRemover remover{eliminator.m_pendingRemovals};
+		remover.visit(_statement);
+	};
 }
 
 void EqualStoreEliminator::visit(Statement& _statement)
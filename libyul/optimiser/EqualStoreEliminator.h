@@ -36,16 +36,16 @@ namespace solidity::yul
  *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
-class EqualStoreEliminator: public DataFlowAnalyzer
+class EqualStoreEliminator: public DataFlowAnalyzer, public FunctionLocalStep<EqualStoreEliminator>
 {
 public:
 	static constexpr char const* name{"EqualStoreEliminator"};
-	static void run(OptimiserStepContext const&, Block& _ast);
+	static FunctionLocalTransform functionLocalTransform(OptimiserStepContext&, Block const& _ast);
 
 private:
 	EqualStoreEliminator(
 		Dialect const& _dialect,
-		std::map<YulString, SideEffects> _functionSideEffects
+		std::shared_ptr<std::map<YulString, SideEffects> const> _functionSideEffects
 	):
 		DataFlowAnalyzer(_dialect, MemoryAndStorage::Analyze, std::move(_functionSideEffects))
 	{}
@@ -32,9 +32,11 @@
 using namespace solidity;
 using namespace solidity::yul;
 
-void ExpressionSimplifier::run(OptimiserStepContext& _context, Block& _ast)
+FunctionLocalTransform ExpressionSimplifier::functionLocalTransform(OptimiserStepContext& _context, Block const&)
 {
-	ExpressionSimplifier{_context.dialect}(_ast);
+	return [&dialect = _context.dialect](Statement& _statement) {
+		ExpressionSimplifier{dialect}.visit(_statement);
+	};
 }
 
 void ExpressionSimplifier::visit(Expression& _expression)
@@ -24,11 +24,11 @@
 #include <libyul/ASTForward.h>
 
 #include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/OptimiserStep.h>
 
 namespace solidity::yul
 {
 struct Dialect;
-struct OptimiserStepContext;
 
 /**
  * Applies simplification rules to all expressions.
@@ -41,13 +41,14 @@ struct OptimiserStepContext;
  *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
-class ExpressionSimplifier: public DataFlowAnalyzer
+class ExpressionSimplifier: public DataFlowAnalyzer, public FunctionLocalStep<ExpressionSimplifier>
 {
 public:
 	static constexpr char const* name{"ExpressionSimplifier"};
-	static void run(OptimiserStepContext&, Block& _ast);
+	static FunctionLocalTransform functionLocalTransform(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
+	using ASTModifier::visit;
 	void visit(Expression& _expression) override;
 
 private:
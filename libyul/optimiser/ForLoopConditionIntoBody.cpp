@@ -25,9 +25,11 @@
 using namespace solidity;
 using namespace solidity::yul;
 
-void ForLoopConditionIntoBody::run(OptimiserStepContext& _context, Block& _ast)
+FunctionLocalTransform ForLoopConditionIntoBody::functionLocalTransform(OptimiserStepContext& _context, Block const&)
 {
-	ForLoopConditionIntoBody{_context.dialect}(_ast);
+	return [&dialect = _context.dialect](Statement& _statement) {
+		ForLoopConditionIntoBody{dialect}.visit(_statement);
+	};
 }
 
 void ForLoopConditionIntoBody::operator()(ForLoop& _forLoop)
@@ -18,13 +18,12 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/Dialect.h>
 
 namespace solidity::yul
 {
 
-struct OptimiserStepContext;
-
 /**
  * Rewrites ForLoop by moving iteration condition into the ForLoop body.
  * For example, `for {} lt(a, b) {} { mstore(1, 2) }` will become
@@ -40,11 +39,11 @@ struct OptimiserStepContext;
  * - To avoid unnecessary rewrite, it is recommended to run this rewriter after StructuralSimplifier.
  * - Only works for dialects with a builtin boolean negation function.
  */
-class ForLoopConditionIntoBody: public ASTModifier
+class ForLoopConditionIntoBody: public ASTModifier, public FunctionLocalStep<ForLoopConditionIntoBody>
 {
 public:
 	static constexpr char const* name{"ForLoopConditionIntoBody"};
-	static void run(OptimiserStepContext&, Block& _ast);
+	static FunctionLocalTransform functionLocalTransform(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(ForLoop& _forLoop) override;
@@ -26,9 +26,11 @@
 using namespace solidity;
 using namespace solidity::yul;
 
-void ForLoopConditionOutOfBody::run(OptimiserStepContext& _context, Block& _ast)
+FunctionLocalTransform ForLoopConditionOutOfBody::functionLocalTransform(OptimiserStepContext& _context, Block const&)
 {
-	ForLoopConditionOutOfBody{_context.dialect}(_ast);
+	return [&dialect = _context.dialect](Statement& _statement) {
+		ForLoopConditionOutOfBody{dialect}.visit(_statement);
+	};
 }
 
 void ForLoopConditionOutOfBody::operator()(ForLoop& _forLoop)
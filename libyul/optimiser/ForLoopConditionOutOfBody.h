@@ -55,11 +55,11 @@ namespace solidity::yul
  *
  * The LiteralRematerialiser should be run before this step.
  */
-class ForLoopConditionOutOfBody: public ASTModifier
+class ForLoopConditionOutOfBody: public ASTModifier, public FunctionLocalStep<ForLoopConditionOutOfBody>
 {
 public:
 	static constexpr char const* name{"ForLoopConditionOutOfBody"};
-	static void run(OptimiserStepContext&, Block& _ast);
+	static FunctionLocalTransform functionLocalTransform(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(ForLoop& _forLoop) override;
@@ -30,6 +30,7 @@
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
@@ -44,14 +45,91 @@
 using namespace solidity;
 using namespace solidity::yul;
 
+namespace
+{
+
+/// Collects the function calls the InlineModifier considers for inlining, i.e. the ones
+/// at the root of expression statements, assignments and variable declarations, together
+/// with the number of loops they are nested in.
+class InlinableCallCollector: public ASTWalker
+{
+public:
+	static std::vector<std::pair<FunctionCall const*, size_t>> run(Block const& _block)
+	{
+		InlinableCallCollector collector;
+		collector(_block);
+		return std::move(collector.m_calls);
+	}
+
+	using ASTWalker::operator();
+	using ASTWalker::visit;
+	void operator()(ForLoop const& _loop) override
+	{
+		++m_loopDepth;
+		ASTWalker::operator()(_loop);
+		--m_loopDepth;
+	}
+	void visit(Statement const& _statement) override
+	{
+		ASTWalker::visit(_statement);
+		Expression const* e = std::visit(util::GenericVisitor{
+			util::VisitorFallback<Expression const*>{},
+			[](ExpressionStatement const& _s) -> Expression const* { return &_s.expression; },
+			[](Assignment const& _s) -> Expression const* { return _s.value.get(); },
+			[](VariableDeclaration const& _s) -> Expression const* { return _s.value.get(); }
+		}, _statement);
+		if (e)
+			if (FunctionCall const* funCall = std::get_if<FunctionCall>(e))
+				m_calls.emplace_back(funCall, m_loopDepth);
+	}
+
+private:
+	std::vector<std::pair<FunctionCall const*, size_t>> m_calls;
+	size_t m_loopDepth = 0;
+};
+
+}
+
 void FullInliner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	FullInliner inliner{_ast, _context.dispenser, _context.dialect};
+	FullInliner inliner{
+		_ast,
+		_context.dispenser,
+		_context.dialect,
+		_context.expectedExecutionsPerDeployment,
+		_context.inlineBudget
+	};
+	size_t const sizeBefore = _context.inlineBudget ? liveCodeSize(_ast) : 0;
 	inliner.run(Pass::InlineTiny);
 	inliner.run(Pass::InlineRest);
+	if (_context.inlineBudget)
+	{
+		// The sizes of the functions used during inlining are only estimates, so the budget is
+		// reduced by the actual growth of the code, but not below zero.
+		size_t const sizeAfter = liveCodeSize(_ast);
+		if (sizeAfter > sizeBefore)
+			*_context.inlineBudget -= std::min(*_context.inlineBudget, sizeAfter - sizeBefore);
+	}
 }
 
-FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect):
+size_t FullInliner::liveCodeSize(Block const& _ast)
+{
+	std::map<YulString, size_t> references = ReferencesCounter::countReferences(_ast);
+	size_t size = CodeSize::codeSizeIncludingFunctions(_ast);
+	for (auto const& statement: _ast.statements)
+		if (FunctionDefinition const* function = std::get_if<FunctionDefinition>(&statement))
+			if (references[function->name] == 0)
+				size -= CodeWeights{}.functionDefinitionCost + CodeSize::codeSizeIncludingFunctions(function->body);
+	return size;
+}
+
+FullInliner::FullInliner(
+	Block& _ast,
+	NameDispenser& _dispenser,
+	Dialect const& _dialect,
+	std::optional<size_t> _expectedExecutionsPerDeployment,
+	std::optional<size_t> _inlineBudget
+):
 	m_ast(_ast),
 	m_recursiveFunctions(CallGraphGenerator::callGraph(_ast).recursiveFunctions()),
 	m_nameDispenser(_dispenser),
@@ -90,6 +168,31 @@ FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const&
 	// We will perform less aggressive inlining, if no ``memoryguard`` call is found.
 	if (!memoryGuardCalls.empty())
 		m_hasMemoryGuard = true;
+
+	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&m_dialect);
+	// No aggressive inlining with the old code transform.
+	m_dialectAllowsAggressiveInlining =
+		evmDialect &&
+		evmDialect->providesObjectAccess() &&
+		evmDialect->evmVersion() > langutil::EVMVersion::homestead();
+
+	m_inlineBudget = _inlineBudget;
+
+	if (evmDialect)
+	{
+		using evmasm::Instruction;
+		GasMeter meter{
+			*evmDialect,
+			!_expectedExecutionsPerDeployment,
+			_expectedExecutionsPerDeployment ? *_expectedExecutionsPerDeployment : 1
+		};
+		// Pushing the return label, jumping into the function and back.
+		m_callSavings =
+			meter.instructionCosts(Instruction::PUSH1) +
+			2 * (meter.instructionCosts(Instruction::JUMP) + meter.instructionCosts(Instruction::JUMPDEST));
+		// Moving an argument or return value into place.
+		m_argumentSavings = meter.instructionCosts(Instruction::SWAP1);
+	}
 }
 
 void FullInliner::run(Pass _pass)
@@ -115,6 +218,10 @@ void FullInliner::run(Pass _pass)
 	) {
 		return depths.at(_a->name) < depths.at(_b->name);
 	});
+
+	if (m_pass == Pass::InlineRest && m_inlineBudget)
+		planInlining(functions);
+
 	for (FunctionDefinition* fun: functions)
 	{
 		handleBlock(fun->name, fun->body);
@@ -124,6 +231,87 @@ void FullInliner::run(Pass _pass)
 	for (auto& statement: m_ast.statements)
 		if (std::holds_alternative<Block>(statement))
 			handleBlock({}, std::get<Block>(statement));
+
+	m_deferredCalls.clear();
+}
+
+void FullInliner::planInlining(std::vector<FunctionDefinition*> const& _functions)
+{
+	struct Candidate
+	{
+		FunctionCall const* funCall;
+		size_t costs;
+		bigint savings;
+	};
+	std::vector<Candidate> candidates;
+	size_t totalCosts = 0;
+	auto collect = [&](YulString _callSite, Block const& _block) {
+		for (auto const& [funCall, loopDepth]: InlinableCallCollector::run(_block))
+			if (shallInline(*funCall, _callSite))
+			{
+				size_t costs = inliningCosts(funCall->functionName.name);
+				totalCosts += costs;
+				candidates.emplace_back(Candidate{funCall, costs, inliningSavings(*funCall, loopDepth)});
+			}
+	};
+	for (FunctionDefinition const* fun: _functions)
+		collect(fun->name, fun->body);
+	for (auto const& statement: m_ast.statements)
+		if (std::holds_alternative<Block>(statement))
+			collect({}, std::get<Block>(statement));
+
+	yulAssert(m_usedInlineBudget <= *m_inlineBudget);
+	size_t remainingBudget = *m_inlineBudget - m_usedInlineBudget;
+	if (totalCosts <= remainingBudget)
+		return;
+
+	// Prefer the call sites that save the most gas per unit of code size.
+	// Candidates that do not grow the code come first.
+	std::stable_sort(candidates.begin(), candidates.end(), [](Candidate const& _a, Candidate const& _b) {
+		if (_a.costs == 0 || _b.costs == 0)
+			return _a.costs == 0 && _b.costs != 0;
+		return _a.savings * _b.costs > _b.savings * _a.costs;
+	});
+	for (Candidate const& candidate: candidates)
+		if (candidate.costs <= remainingBudget)
+			remainingBudget -= candidate.costs;
+		else
+			m_deferredCalls.insert(candidate.funCall);
+}
+
+size_t FullInliner::inliningCosts(YulString _function) const
+{
+	size_t size = m_functionSizes.at(_function);
+	// Functions that are called only once are removed after inlining and
+	// tiny functions are not larger than the call itself.
+	if (size <= 1 || m_singleUse.count(_function))
+		return 0;
+	return size;
+}
+
+bigint FullInliner::inliningSavings(FunctionCall const& _funCall, size_t _loopDepth) const
+{
+	FunctionDefinition const& calledFunction = *m_functions.at(_funCall.functionName.name);
+	bigint savings =
+		m_callSavings +
+		m_argumentSavings * (calledFunction.parameters.size() + calledFunction.returnVariables.size());
+	// Constant arguments might provide a means for further optimization.
+	if (hasConstantArgument(_funCall))
+		savings *= 2;
+	for (size_t i = 0; i < _loopDepth; ++i)
+		savings *= loopIterationEstimate;
+	return savings;
+}
+
+bool FullInliner::hasConstantArgument(FunctionCall const& _funCall) const
+{
+	for (auto const& argument: _funCall.arguments)
+		if (std::holds_alternative<Literal>(argument) || (
+			std::holds_alternative<Identifier>(argument) &&
+			m_constants.count(std::get<Identifier>(argument).name)
+		))
+			return true;
+	return false;
 }
 
 std::map<YulString, size_t> FullInliner::callDepths() const
@@ -194,6 +382,13 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 		if (!std::holds_alternative<Literal>(argument) && !std::holds_alternative<Identifier>(argument))
 			return false;
 
+	if (m_deferredCalls.count(&_funCall))
+		return false;
+
+	// Calls inlined earlier in the pass can have grown the called function beyond the plan.
+	if (m_inlineBudget && m_usedInlineBudget + inliningCosts(calledFunction->name) > *m_inlineBudget)
+		return false;
+
 	// Inline really, really tiny functions
 	size_t size = m_functionSizes.at(calledFunction->name);
 	if (size <= 1)
@@ -203,14 +398,7 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 	if (m_pass == Pass::InlineTiny)
 		return false;
 
-	bool aggressiveInlining = true;
-
-	if (
-		EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&m_dialect);
-		!evmDialect || !evmDialect->providesObjectAccess() || evmDialect->evmVersion() <= langutil::EVMVersion::homestead()
-	)
-		// No aggressive inlining with the old code transform.
-		aggressiveInlining = false;
+	bool aggressiveInlining = m_dialectAllowsAggressiveInlining;
 
 	// No aggressive inlining, if we cannot perform stack-to-memory.
 	if (!m_hasMemoryGuard || m_recursiveFunctions.count(_callSite))
@@ -223,28 +411,22 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 		return true;
 
 	// Constant arguments might provide a means for further optimization, so they cause a bonus.
-	bool constantArg = false;
-	for (auto const& argument: _funCall.arguments)
-		if (std::holds_alternative<Literal>(argument) || (
-			std::holds_alternative<Identifier>(argument) &&
-			m_constants.count(std::get<Identifier>(argument).name)
-		))
-		{
-			constantArg = true;
-			break;
-		}
+	bool constantArg = hasConstantArgument(_funCall);
 
 	return (size < (aggressiveInlining ? 8u : 6u) || (constantArg && size < (aggressiveInlining ? 16u : 12u)));
 }
 
 void FullInliner::tentativelyUpdateCodeSize(YulString _function, YulString _callSite)
 {
+	if (m_inlineBudget)
+		m_usedInlineBudget += inliningCosts(_function);
 	m_functionSizes.at(_callSite) += m_functionSizes.at(_function);
 }
 
 void FullInliner::updateCodeSize(FunctionDefinition const& _fun)
 {
 	m_functionSizes[_fun.name] = CodeSize::codeSize(_fun.body);
+	m_directlyRecursive.erase(_fun.name);
 }
 
 void FullInliner::handleBlock(YulString _currentFunctionName, Block& _block)
@@ -252,10 +434,15 @@ void FullInliner::handleBlock(YulString _currentFunctionName, Block& _block)
 	InlineModifier{*this, m_nameDispenser, _currentFunctionName, m_dialect}(_block);
 }
 
-bool FullInliner::recursive(FunctionDefinition const& _fun) const
+bool FullInliner::recursive(FunctionDefinition const& _fun)
 {
-	std::map<YulString, size_t> references = ReferencesCounter::countReferences(_fun);
-	return references[_fun.name] > 0;
+	auto [it, inserted] = m_directlyRecursive.emplace(_fun.name, false);
+	if (inserted)
+	{
+		std::map<YulString, size_t> references = ReferencesCounter::countReferences(_fun);
+		it->second = references[_fun.name] > 0;
+	}
+	return it->second;
 }
 
 void InlineModifier::operator()(Block& _block)
@@ -30,6 +30,8 @@
 
 #include <liblangutil/SourceLocation.h>
 
+#include <libsolutil/Numeric.h>
+
 #include <optional>
 #include <set>
 #include <utility>
@@ -64,6 +66,13 @@ class NameCollector;
  * code of f, with replacements: a -> f_a, b -> f_b, c -> f_c
  * let z := f_c
  *
+ * Inlining a function that is called more than once grows the code. If the context provides
+ * a code size budget, all call sites the heuristic would inline are ranked by the gas they save
+ * per unit of code size before the main pass and inlined in that order until the budget is used
+ * up. The remaining ones are kept as calls. Calls inside loops are assumed to save more gas the
+ * deeper they are nested. The budget is shared by all runs of the step and reduced by the code
+ * size each run actually adds. Without a budget, the heuristic alone decides.
+ *
  * Prerequisites: Disambiguator
  * More efficient if run after: Function Hoister, Expression Splitter
  */
@@ -93,16 +102,39 @@ public:
 private:
 	enum Pass { InlineTiny, InlineRest };
 
-	FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect);
+	/// Estimated number of iterations of a loop, by which the savings of a call in its body are multiplied.
+	static size_t constexpr loopIterationEstimate = 10;
+
+	FullInliner(
+		Block& _ast,
+		NameDispenser& _dispenser,
+		Dialect const& _dialect,
+		std::optional<size_t> _expectedExecutionsPerDeployment,
+		std::optional<size_t> _inlineBudget
+	);
 	void run(Pass _pass);
 
+	/// Determines the call sites in @a _functions and the global blocks that the heuristic
+	/// would inline and defers the ones least worth inlining if the remaining code size
+	/// budget does not suffice for all of them.
+	void planInlining(std::vector<FunctionDefinition*> const& _functions);
+	/// @returns the size of the code without the functions that are not called any more,
+	/// since those are removed after inlining.
+	static size_t liveCodeSize(Block const& _ast);
+	/// @returns the code size by which inlining a call to @a _function grows the code.
+	size_t inliningCosts(YulString _function) const;
+	/// @returns the estimated gas saved by not calling a function at @a _funCall,
+	/// which is nested in @a _loopDepth loops.
+	bigint inliningSavings(FunctionCall const& _funCall, size_t _loopDepth) const;
+	bool hasConstantArgument(FunctionCall const& _funCall) const;
+
 	/// @returns a map containing the maximum depths of a call chain starting at each
 	/// function. For recursive functions, the value is one larger than for all others.
 	std::map<YulString, size_t> callDepths() const;
 
 	void updateCodeSize(FunctionDefinition const& _fun);
 	void handleBlock(YulString _currentFunctionName, Block& _block);
-	bool recursive(FunctionDefinition const& _fun) const;
+	bool recursive(FunctionDefinition const& _fun);
 
 	Pass m_pass;
 	/// The AST to be modified. The root block itself will not be modified, because
@@ -113,6 +145,8 @@ private:
 	std::set<YulString> m_noInlineFunctions;
 	/// True, if the code contains a ``memoryguard`` and we can expect to be able to move variables to memory later.
 	bool m_hasMemoryGuard = false;
+	/// False, if the dialect does not allow aggressive inlining, e.g. because of the old code transform.
+	bool m_dialectAllowsAggressiveInlining = false;
 	/// Set of recursive functions.
 	std::set<YulString> m_recursiveFunctions;
 	/// Names of functions to always inline.
@@ -120,6 +154,19 @@ private:
 	/// Variables that are constants (used for inlining heuristic)
 	std::set<YulString> m_constants;
 	std::map<YulString, size_t> m_functionSizes;
+	/// Cache of whether functions call themselves directly. Entries are removed when the
+	/// body of the function changes.
+	std::map<YulString, bool> m_directlyRecursive;
+	/// Code size by which inlining may grow the code in the main pass. Unlimited if nullopt.
+	std::optional<size_t> m_inlineBudget;
+	/// Part of the budget taken by the call sites inlined so far, estimated from the current
+	/// sizes of the inlined functions.
+	size_t m_usedInlineBudget = 0;
+	/// Estimated gas saved by inlining a call, without and per argument or return value.
+	bigint m_callSavings = 1;
+	bigint m_argumentSavings = 0;
+	/// Call sites that are not inlined in the current pass because the budget is used up.
+	std::set<FunctionCall const*> m_deferredCalls;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
 };
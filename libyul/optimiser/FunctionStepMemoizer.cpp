@@ -0,0 +1,370 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/FunctionStepMemoizer.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/ExpressionSimplifier.h>
+#include <libyul/optimiser/ForLoopConditionIntoBody.h>
+#include <libyul/optimiser/ForLoopConditionOutOfBody.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/StructuralSimplifier.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+#include <libyul/OptimizedCodeCache.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
+
+#include <map>
+#include <memory>
+#include <set>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Replaces the debug data of all nodes by the debug data they are mapped to.
+class DebugDataReplacer: public ASTModifier
+{
+public:
+	explicit DebugDataReplacer(std::map<langutil::DebugData const*, langutil::DebugData::ConstPtr> const& _replacements):
+		m_replacements(_replacements)
+	{}
+
+	/// @returns true if all debug data could be replaced.
+	bool succeeded() const { return m_succeeded; }
+
+	using ASTModifier::operator();
+	void operator()(Literal& _literal) override { replace(_literal.debugData); }
+	void operator()(Identifier& _identifier) override { replace(_identifier.debugData); }
+	void operator()(FunctionCall& _call) override
+	{
+		replace(_call.debugData);
+		(*this)(_call.functionName);
+		ASTModifier::operator()(_call);
+	}
+	void operator()(ExpressionStatement& _statement) override
+	{
+		replace(_statement.debugData);
+		ASTModifier::operator()(_statement);
+	}
+	void operator()(Assignment& _assignment) override
+	{
+		replace(_assignment.debugData);
+		ASTModifier::operator()(_assignment);
+	}
+	void operator()(VariableDeclaration& _declaration) override
+	{
+		replace(_declaration.debugData);
+		for (TypedName& variable: _declaration.variables)
+			replace(variable.debugData);
+		ASTModifier::operator()(_declaration);
+	}
+	void operator()(If& _if) override
+	{
+		replace(_if.debugData);
+		ASTModifier::operator()(_if);
+	}
+	void operator()(Switch& _switch) override
+	{
+		replace(_switch.debugData);
+		for (Case& _case: _switch.cases)
+			replace(_case.debugData);
+		ASTModifier::operator()(_switch);
+	}
+	void operator()(FunctionDefinition& _function) override
+	{
+		replace(_function.debugData);
+		for (TypedName& parameter: _function.parameters)
+			replace(parameter.debugData);
+		for (TypedName& returnVariable: _function.returnVariables)
+			replace(returnVariable.debugData);
+		ASTModifier::operator()(_function);
+	}
+	void operator()(ForLoop& _forLoop) override
+	{
+		replace(_forLoop.debugData);
+		ASTModifier::operator()(_forLoop);
+	}
+	void operator()(Break& _break) override { replace(_break.debugData); }
+	void operator()(Continue& _continue) override { replace(_continue.debugData); }
+	void operator()(Leave& _leave) override { replace(_leave.debugData); }
+	void operator()(Block& _block) override
+	{
+		replace(_block.debugData);
+		ASTModifier::operator()(_block);
+	}
+
+private:
+	void replace(langutil::DebugData::ConstPtr& _debugData)
+	{
+		if (!_debugData)
+			return;
+		if (auto const* replacement = util::valueOrNullptr(m_replacements, _debugData.get()))
+			_debugData = *replacement;
+		else
+			m_succeeded = false;
+	}
+
+	std::map<langutil::DebugData const*, langutil::DebugData::ConstPtr> const& m_replacements;
+	bool m_succeeded = true;
+};
+
+/// Compares code exactly, including all names, literal representations and the source locations
+/// in the original source. In contrast to SyntacticallyEqual, variable names have to match as well.
+/// Locations in the Yul code are not compared, since they differ between the objects functions are
+/// shared between. Instead, the debug data of corresponding nodes are recorded, so that the
+/// locations of the right-hand side can be transferred to code derived from the left-hand side.
+class IdenticalCode
+{
+public:
+	/// @returns a copy of @a _code, which was derived from the left-hand side of the previous
+	/// comparisons, with the debug data of the corresponding nodes of the right-hand side.
+	/// @returns nullopt if some debug data of @a _code does not occur on the left-hand side.
+	std::optional<Statement> withRightHandSideDebugData(Statement const& _code) const
+	{
+		Statement copy = ASTCopier{}.translate(_code);
+		DebugDataReplacer replacer{m_correspondingDebugData};
+		replacer.visit(copy);
+		if (!replacer.succeeded())
+			return std::nullopt;
+		return copy;
+	}
+
+	bool operator()(Statement const& _lhs, Statement const& _rhs) const
+	{
+		return std::visit([&](auto const& _l, auto const& _r) { return equal(_l, _r); }, _lhs, _rhs);
+	}
+	bool operator()(Expression const& _lhs, Expression const& _rhs) const
+	{
+		return std::visit([&](auto const& _l, auto const& _r) { return equal(_l, _r); }, _lhs, _rhs);
+	}
+
+private:
+	template<typename U, typename V>
+	bool equal(U const&, V const&) const { return false; }
+
+	bool equal(langutil::DebugData::ConstPtr const& _lhs, langutil::DebugData::ConstPtr const& _rhs) const
+	{
+		if (!_lhs || !_rhs)
+			return _lhs == _rhs;
+		if (_lhs != _rhs && (_lhs->originLocation != _rhs->originLocation || _lhs->astID != _rhs->astID))
+			return false;
+		// Nodes sharing their debug data on the left-hand side need the same locations on the right-hand side.
+		auto [it, inserted] = m_correspondingDebugData.emplace(_lhs.get(), _rhs);
+		return inserted || it->second->nativeLocation == _rhs->nativeLocation;
+	}
+	bool equal(std::unique_ptr<Expression> const& _lhs, std::unique_ptr<Expression> const& _rhs) const
+	{
+		return (!_lhs && !_rhs) || (_lhs && _rhs && (*this)(*_lhs, *_rhs));
+	}
+	template<typename T>
+	bool equal(std::vector<T> const& _lhs, std::vector<T> const& _rhs) const
+	{
+		return util::containerEqual(_lhs, _rhs, [&](T const& _l, T const& _r) { return equal(_l, _r); });
+	}
+	bool equal(Expression const& _lhs, Expression const& _rhs) const { return (*this)(_lhs, _rhs); }
+	bool equal(Statement const& _lhs, Statement const& _rhs) const { return (*this)(_lhs, _rhs); }
+
+	bool equal(Literal const& _lhs, Literal const& _rhs) const
+	{
+		auto const& lhsHint = _lhs.value.hint();
+		auto const& rhsHint = _rhs.value.hint();
+		return
+			equal(_lhs.debugData, _rhs.debugData) &&
+			_lhs.kind == _rhs.kind &&
+			_lhs.type == _rhs.type &&
+			_lhs.value == _rhs.value &&
+			(lhsHint == rhsHint || (lhsHint && rhsHint && *lhsHint == *rhsHint));
+	}
+	bool equal(Identifier const& _lhs, Identifier const& _rhs) const
+	{
+		return equal(_lhs.debugData, _rhs.debugData) && _lhs.name == _rhs.name;
+	}
+	bool equal(TypedName const& _lhs, TypedName const& _rhs) const
+	{
+		return equal(_lhs.debugData, _rhs.debugData) && _lhs.name == _rhs.name && _lhs.type == _rhs.type;
+	}
+	bool equal(FunctionCall const& _lhs, FunctionCall const& _rhs) const
+	{
+		return
+			equal(_lhs.debugData, _rhs.debugData) &&
+			equal(_lhs.functionName, _rhs.functionName) &&
+			equal(_lhs.arguments, _rhs.arguments);
+	}
+	bool equal(ExpressionStatement const& _lhs, ExpressionStatement const& _rhs) const
+	{
+		return equal(_lhs.debugData, _rhs.debugData) && (*this)(_lhs.expression, _rhs.expression);
+	}
+	bool equal(Assignment const& _lhs, Assignment const& _rhs) const
+	{
+		return
+			equal(_lhs.debugData, _rhs.debugData) &&
+			equal(_lhs.variableNames, _rhs.variableNames) &&
+			equal(_lhs.value, _rhs.value);
+	}
+	bool equal(VariableDeclaration const& _lhs, VariableDeclaration const& _rhs) const
+	{
+		return
+			equal(_lhs.debugData, _rhs.debugData) &&
+			equal(_lhs.variables, _rhs.variables) &&
+			equal(_lhs.value, _rhs.value);
+	}
+	bool equal(Block const& _lhs, Block const& _rhs) const
+	{
+		return equal(_lhs.debugData, _rhs.debugData) && equal(_lhs.statements, _rhs.statements);
+	}
+	bool equal(FunctionDefinition const& _lhs, FunctionDefinition const& _rhs) const
+	{
+		return
+			equal(_lhs.debugData, _rhs.debugData) &&
+			_lhs.name == _rhs.name &&
+			equal(_lhs.parameters, _rhs.parameters) &&
+			equal(_lhs.returnVariables, _rhs.returnVariables) &&
+			equal(_lhs.body, _rhs.body);
+	}
+	bool equal(If const& _lhs, If const& _rhs) const
+	{
+		return
+			equal(_lhs.debugData, _rhs.debugData) &&
+			equal(_lhs.condition, _rhs.condition) &&
+			equal(_lhs.body, _rhs.body);
+	}
+	bool equal(Case const& _lhs, Case const& _rhs) const
+	{
+		return
+			equal(_lhs.debugData, _rhs.debugData) &&
+			((!_lhs.value && !_rhs.value) || (_lhs.value && _rhs.value && equal(*_lhs.value, *_rhs.value))) &&
+			equal(_lhs.body, _rhs.body);
+	}
+	bool equal(Switch const& _lhs, Switch const& _rhs) const
+	{
+		return
+			equal(_lhs.debugData, _rhs.debugData) &&
+			equal(_lhs.expression, _rhs.expression) &&
+			equal(_lhs.cases, _rhs.cases);
+	}
+	bool equal(ForLoop const& _lhs, ForLoop const& _rhs) const
+	{
+		return
+			equal(_lhs.debugData, _rhs.debugData) &&
+			equal(_lhs.pre, _rhs.pre) &&
+			equal(_lhs.condition, _rhs.condition) &&
+			equal(_lhs.post, _rhs.post) &&
+			equal(_lhs.body, _rhs.body);
+	}
+	bool equal(Break const& _lhs, Break const& _rhs) const { return equal(_lhs.debugData, _rhs.debugData); }
+	bool equal(Continue const& _lhs, Continue const& _rhs) const { return equal(_lhs.debugData, _rhs.debugData); }
+	bool equal(Leave const& _lhs, Leave const& _rhs) const { return equal(_lhs.debugData, _rhs.debugData); }
+
+	mutable std::map<langutil::DebugData const*, langutil::DebugData::ConstPtr> m_correspondingDebugData;
+};
+
+std::optional<std::string> dialectKey(Dialect const& _dialect)
+{
+	// The EVM dialects differ in their version, the availability of the object access builtins
+	// and the types. Nothing is memoized for other dialects.
+	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect);
+	if (!evmDialect)
+		return std::nullopt;
+	std::string key = evmDialect->evmVersion().name();
+	key += evmDialect->providesObjectAccess() ? ":objects" : ":plain";
+	key += dynamic_cast<EVMDialectTyped const*>(evmDialect) ? ":typed" : ":untyped";
+	return key;
+}
+
+}
+
+FunctionStepMemoizer::FunctionStepMemoizer(OptimizedCodeCache& _cache, Dialect const& _dialect, size_t _maxFunctionSize):
+	m_cache(_cache),
+	m_dialectKey(dialectKey(_dialect)),
+	m_maxFunctionSize(_maxFunctionSize)
+{
+}
+
+bool FunctionStepMemoizer::memoizes(OptimiserStep const& _step)
+{
+	static std::set<std::string> const contextFreeSteps{
+		ExpressionSimplifier::name,
+		ForLoopConditionIntoBody::name,
+		ForLoopConditionOutOfBody::name,
+		StructuralSimplifier::name,
+	};
+	return contextFreeSteps.count(_step.name) > 0;
+}
+
+void FunctionStepMemoizer::apply(
+	OptimiserStep const& _step,
+	FunctionLocalTransform const& _transform,
+	Statement& _statement
+) const
+{
+	// Entries consist of the function before and after the step.
+	std::optional<util::h256> entryKey = key(_step, _statement);
+	if (entryKey)
+		if (std::shared_ptr<Block const> cachedEntry = m_cache.find(*entryKey))
+		{
+			IdenticalCode identicalCode;
+			if (identicalCode(cachedEntry->statements.front(), _statement))
+				if (std::optional<Statement> result = identicalCode.withRightHandSideDebugData(cachedEntry->statements.back()))
+				{
+					_statement = std::move(*result);
+					return;
+				}
+			entryKey.reset();
+		}
+
+	std::shared_ptr<Block> entry;
+	if (entryKey)
+	{
+		entry = std::make_shared<Block>();
+		entry->statements.emplace_back(ASTCopier{}.translate(_statement));
+	}
+
+	_transform(_statement);
+
+	if (entryKey)
+	{
+		entry->statements.emplace_back(ASTCopier{}.translate(_statement));
+		m_cache.insert(*entryKey, std::move(entry));
+	}
+}
+
+std::optional<util::h256> FunctionStepMemoizer::key(OptimiserStep const& _step, Statement const& _statement) const
+{
+	FunctionDefinition const* function = std::get_if<FunctionDefinition>(&_statement);
+	if (
+		!m_dialectKey ||
+		!function ||
+		!memoizes(_step) ||
+		CodeSize::codeSize(function->body) > m_maxFunctionSize
+	)
+		return std::nullopt;
+
+	std::string key = function->name.str();
+	key += "\n" + std::to_string(function->parameters.size()) + ":" + std::to_string(function->returnVariables.size());
+	key += "\n" + std::to_string(ASTHasher::run(function->body));
+	key += "\n" + _step.name;
+	key += "\n" + *m_dialectKey;
+	return util::keccak256(key);
+}
@@ -0,0 +1,86 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Memoization of optimiser steps on single functions.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/ASTForward.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <optional>
+#include <string>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+class OptimizedCodeCache;
+
+/**
+ * Stores the results of context-free function-local optimiser steps on small function
+ * definitions in an OptimizedCodeCache, so that helper functions that occur in many objects
+ * of a compilation are only transformed once.
+ *
+ * A step is context-free if its result on a function only depends on the function itself and
+ * on the dialect. Such steps do not create new names, so their results can be reused in any
+ * other code. Entries are keyed on a hash of the structure of the function and compared to the
+ * function exactly before they are used, apart from the locations in the Yul code, which are
+ * taken over from the function.
+ *
+ * Can be used from multiple threads.
+ */
+class FunctionStepMemoizer
+{
+public:
+	/// Functions whose body is larger than this code size are not memoized by default.
+	/// The functions the IR generator emits for ABI coding, cleanups, checked arithmetic
+	/// and panics, which recur in many contracts, are a lot smaller. Larger functions are
+	/// mostly specific to a single contract, and storing them would only cost the copies
+	/// and the comparisons.
+	static size_t constexpr defaultMaxFunctionSize = 200;
+
+	FunctionStepMemoizer(
+		OptimizedCodeCache& _cache,
+		Dialect const& _dialect,
+		size_t _maxFunctionSize = defaultMaxFunctionSize
+	);
+
+	/// @returns true if the results of @a _step are memoized.
+	static bool memoizes(OptimiserStep const& _step);
+
+	/// Applies @a _transform, the transform of the function-local step @a _step, to @a _statement,
+	/// a top-level statement of grouped code, or takes the result from the cache.
+	void apply(OptimiserStep const& _step, FunctionLocalTransform const& _transform, Statement& _statement) const;
+
+private:
+	/// @returns the key under which the result of @a _step on @a _statement is memoized
+	/// or nullopt if it is not memoized.
+	std::optional<util::h256> key(OptimiserStep const& _step, Statement const& _statement) const;
+
+	OptimizedCodeCache& m_cache;
+	/// Everything about the dialect the context-free steps depend on, or nullopt if nothing is
+	/// memoized for the dialect.
+	std::optional<std::string> m_dialectKey;
+	size_t m_maxFunctionSize;
+};
+
+}
@@ -41,15 +41,20 @@ using namespace solidity::util;
 using namespace solidity::evmasm;
 using namespace solidity::yul;
 
-void LoadResolver::run(OptimiserStepContext& _context, Block& _ast)
+FunctionLocalTransform LoadResolver::functionLocalTransform(OptimiserStepContext& _context, Block const& _ast)
 {
 	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
-	LoadResolver{
-		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
-		containsMSize,
-		_context.expectedExecutionsPerDeployment
-	}(_ast);
+	auto functionSideEffects = std::make_shared<std::map<YulString, SideEffects> const>(
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+	);
+	return [&_context, functionSideEffects, containsMSize](Statement& _statement) {
+		LoadResolver{
+			_context.dialect,
+			functionSideEffects,
+			containsMSize,
+			_context.expectedExecutionsPerDeployment
+		}.visit(_statement);
+	};
 }
 
 void LoadResolver::visit(Expression& _e)
@@ -39,17 +39,17 @@ namespace solidity::yul
  *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
-class LoadResolver: public DataFlowAnalyzer
+class LoadResolver: public DataFlowAnalyzer, public FunctionLocalStep<LoadResolver>
 {
 public:
 	static constexpr char const* name{"LoadResolver"};
 	/// Run the load resolver on the given complete AST.
-	static void run(OptimiserStepContext&, Block& _ast);
+	static FunctionLocalTransform functionLocalTransform(OptimiserStepContext&, Block const& _ast);
 
 private:
 	LoadResolver(
 		Dialect const& _dialect,
-		std::map<YulString, SideEffects> _functionSideEffects,
+		std::shared_ptr<std::map<YulString, SideEffects> const> _functionSideEffects,
 		bool _containsMSize,
 		std::optional<size_t> _expectedExecutionsPerDeployment
 	):
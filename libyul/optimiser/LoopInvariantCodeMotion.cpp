@@ -30,13 +30,16 @@
 using namespace solidity;
 using namespace solidity::yul;
 
-void LoopInvariantCodeMotion::run(OptimiserStepContext& _context, Block& _ast)
+FunctionLocalTransform LoopInvariantCodeMotion::functionLocalTransform(OptimiserStepContext& _context, Block const& _ast)
 {
-	std::map<YulString, SideEffects> functionSideEffects =
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+	auto functionSideEffects = std::make_shared<std::map<YulString, SideEffects> const>(
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+	);
 	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
-	std::set<YulString> ssaVars = SSAValueTracker::ssaVariables(_ast);
-	LoopInvariantCodeMotion{_context.dialect, ssaVars, functionSideEffects, containsMSize}(_ast);
+	auto ssaVars = std::make_shared<std::set<YulString> const>(SSAValueTracker::ssaVariables(_ast));
+	return [&dialect = _context.dialect, functionSideEffects, containsMSize, ssaVars](Statement& _statement) {
+		LoopInvariantCodeMotion{dialect, *ssaVars, *functionSideEffects, containsMSize}.visit(_statement);
+	};
 }
 
 void LoopInvariantCodeMotion::operator()(Block& _block)
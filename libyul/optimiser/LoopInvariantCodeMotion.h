@@ -37,11 +37,11 @@ namespace solidity::yul
  * - Expression splitter and SSA transform should be run upfront to obtain better result.
  */
 
-class LoopInvariantCodeMotion: public ASTModifier
+class LoopInvariantCodeMotion: public ASTModifier, public FunctionLocalStep<LoopInvariantCodeMotion>
 {
 public:
 	static constexpr char const* name{"LoopInvariantCodeMotion"};
-	static void run(OptimiserStepContext& _context, Block& _ast);
+	static FunctionLocalTransform functionLocalTransform(OptimiserStepContext&, Block const& _ast);
 
 	void operator()(Block& _block) override;
 
@@ -18,17 +18,20 @@
 
 #pragma once
 
+#include <libyul/AST.h>
 #include <libyul/Exceptions.h>
 
+#include <functional>
 #include <optional>
 #include <string>
 #include <set>
+#include <type_traits>
+#include <utility>
 
 namespace solidity::yul
 {
 
 struct Dialect;
-struct Block;
 class YulString;
 class NameDispenser;
 
@@ -39,8 +42,40 @@ struct OptimiserStepContext
 	std::set<YulString> const& reservedIdentifiers;
 	/// The value nullopt represents creation code
 	std::optional<size_t> expectedExecutionsPerDeployment;
+	/// Code size by which the FullInliner may still grow the code by copying function bodies.
+	/// Every run reduces it by the code size it adds. The value nullopt represents no limit.
+	std::optional<size_t> inlineBudget = std::nullopt;
+	/// Effort the optimized code generator spends on the stack layouts, which the steps that
+	/// predict stack too deep errors have to use as well.
+	size_t stackLayoutSearchEffort = 0;
 };
 
+/// Applies a function-local optimiser step to a single statement at the top level of
+/// grouped code, i.e. to the block of instructions or to one of the function definitions.
+using FunctionLocalTransform = std::function<void(Statement&)>;
+
+/**
+ * Base of function-local optimiser steps: On code grouped by the FunctionGrouper, they transform
+ * the block of instructions and every function definition independently of each other, so the
+ * statements can be processed concurrently.
+ *
+ * Instead of ``run``, such a step provides a static method
+ * ``FunctionLocalTransform functionLocalTransform(OptimiserStepContext&, Block const& _ast)``, which
+ * collects everything it needs from the whole code @a _ast, like the side-effects of all functions,
+ * and returns the transformation of a single statement. Run on the whole code, the step applies
+ * that transformation to the block itself.
+ */
+template <class Step>
+struct FunctionLocalStep
+{
+	static void run(OptimiserStepContext& _context, Block& _ast)
+	{
+		FunctionLocalTransform const transform = Step::functionLocalTransform(_context, _ast);
+		Statement block = std::move(_ast);
+		transform(block);
+		_ast = std::get<Block>(std::move(block));
+	}
+};
 
 /**
  * Construction to create dynamically callable objects out of the
@@ -56,6 +91,11 @@ struct OptimiserStep
 	/// an SMT solver to be loaded, but none is available. In that case, the string
 	/// contains a human-readable reason.
 	virtual std::optional<std::string> invalidInCurrentEnvironment() const = 0;
+	virtual bool isFunctionLocal() const = 0;
+	/// Prepares running a function-local step on the grouped code @a _ast. Everything that depends
+	/// on the whole code is determined here. The returned transform can then be called concurrently
+	/// for different top-level statements of @a _ast. Must only be called for function-local steps.
+	virtual FunctionLocalTransform functionLocalTransform(OptimiserStepContext&, Block const& _ast) const = 0;
 	std::string name;
 };
 
@@ -63,6 +103,8 @@ template <class Step>
 struct OptimiserStepInstance: public OptimiserStep
 {
 private:
+	static constexpr bool isFunctionLocalStep = std::is_base_of_v<FunctionLocalStep<Step>, Step>;
+
 	template<typename T>
 	struct HasInvalidInCurrentEnvironmentMethod
 	{
@@ -87,6 +129,20 @@ public:
 		else
 			return std::nullopt;
 	}
+	bool isFunctionLocal() const override
+	{
+		return isFunctionLocalStep;
+	}
+	FunctionLocalTransform functionLocalTransform(OptimiserStepContext& _context, Block const& _ast) const override
+	{
+		if constexpr (isFunctionLocalStep)
+			return Step::functionLocalTransform(_context, _ast);
+		else
+		{
+			yulAssert(false, "Step " + name + " is not function-local.");
+			return {};
+		}
+	}
 };
 
 
@@ -0,0 +1,59 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/OptimiserStepProfile.h>
+
+#include <cstdint>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+Json OptimiserStepProfile::toJson() const
+{
+	Json steps = Json::array();
+	Json summary = Json::object();
+	for (StepRun const& run: m_runs)
+	{
+		int64_t const codeSizeChange = static_cast<int64_t>(run.codeSizeAfter) - static_cast<int64_t>(run.codeSizeBefore);
+
+		Json step;
+		step["step"] = run.step;
+		step["object"] = run.object;
+		step["round"] = run.round;
+		step["durationMicroseconds"] = run.duration.count();
+		step["codeSizeBefore"] = run.codeSizeBefore;
+		step["codeSizeAfter"] = run.codeSizeAfter;
+		steps.emplace_back(std::move(step));
+
+		if (!summary.contains(run.step))
+		{
+			summary[run.step]["runs"] = 0;
+			summary[run.step]["durationMicroseconds"] = 0;
+			summary[run.step]["codeSizeChange"] = 0;
+		}
+		Json& total = summary[run.step];
+		total["runs"] = total["runs"].get<size_t>() + 1;
+		total["durationMicroseconds"] = total["durationMicroseconds"].get<int64_t>() + run.duration.count();
+		total["codeSizeChange"] = total["codeSizeChange"].get<int64_t>() + codeSizeChange;
+	}
+
+	Json profile;
+	profile["steps"] = std::move(steps);
+	profile["summary"] = std::move(summary);
+	return profile;
+}
@@ -0,0 +1,67 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Record of the optimiser steps run on Yul objects.
+ */
+
+#pragma once
+
+#include <libsolutil/JSON.h>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Record of every optimiser step run by the OptimiserSuite, with its duration and its effect
+ * on the code size. Meant for tuning custom step sequences against real code.
+ * Not thread-safe, a profile must not be shared between concurrently optimized objects.
+ */
+class OptimiserStepProfile
+{
+public:
+	struct StepRun
+	{
+		std::string step;
+		/// Name of the Yul object the step ran on.
+		std::string object;
+		/// Iteration of the innermost repeated subsequence (``[...]``) the step ran in,
+		/// starting at one. Zero if the step was not part of a repeated subsequence.
+		size_t round = 0;
+		std::chrono::microseconds duration{};
+		/// Code size of the object including its functions, see CodeSize::codeSizeIncludingFunctions().
+		size_t codeSizeBefore = 0;
+		size_t codeSizeAfter = 0;
+	};
+
+	void record(StepRun _run) { m_runs.emplace_back(std::move(_run)); }
+	std::vector<StepRun> const& runs() const { return m_runs; }
+
+	/// @returns every step run in order as "steps" and the total duration, code size change
+	/// and number of runs per step as "summary".
+	Json toJson() const;
+
+private:
+	std::vector<StepRun> m_runs;
+};
+
+}
@@ -25,11 +25,13 @@
 using namespace solidity;
 using namespace solidity::yul;
 
-void SSAReverser::run(OptimiserStepContext&, Block& _block)
+FunctionLocalTransform SSAReverser::functionLocalTransform(OptimiserStepContext&, Block const& _ast)
 {
-	AssignmentCounter assignmentCounter;
-	assignmentCounter(_block);
-	SSAReverser{assignmentCounter}(_block);
+	auto assignmentCounter = std::make_shared<AssignmentCounter>();
+	(*assignmentCounter)(_ast);
+	return [assignmentCounter](Statement& _statement) {
+		SSAReverser{*assignmentCounter}.visit(_statement);
+	};
 }
 
 void SSAReverser::operator()(Block& _block)
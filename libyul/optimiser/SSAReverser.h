@@ -68,11 +68,11 @@ class AssignmentCounter;
  * Prerequisites: Disambiguator
  *
  */
-class SSAReverser: public ASTModifier
+class SSAReverser: public ASTModifier, public FunctionLocalStep<SSAReverser>
 {
 public:
 	static constexpr char const* name{"SSAReverser"};
-	static void run(OptimiserStepContext& _context, Block& _ast);
+	static FunctionLocalTransform functionLocalTransform(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(Block& _block) override;
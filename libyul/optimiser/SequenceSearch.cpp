@@ -0,0 +1,231 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/SequenceSearch.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/Suite.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/AsmAnalysis.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Object.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/Parallel.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Estimates the gas costs of code, assuming that every part of it is executed once.
+class CostEstimator: public ASTWalker
+{
+public:
+	CostEstimator(Dialect const& _dialect, GasMeter const& _meter):
+		m_dialect(_dialect),
+		m_meter(_meter),
+		m_pushCosts(_meter.instructionCosts(evmasm::Instruction::PUSH1)),
+		m_jumpCosts(_meter.instructionCosts(evmasm::Instruction::JUMP) + _meter.instructionCosts(evmasm::Instruction::JUMPDEST)),
+		m_conditionalJumpCosts(_meter.instructionCosts(evmasm::Instruction::JUMPI) + _meter.instructionCosts(evmasm::Instruction::JUMPDEST))
+	{}
+
+	bigint costs() const { return m_costs; }
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _funCall) override
+	{
+		ASTWalker::operator()(_funCall);
+		if (std::optional<evmasm::Instruction> instruction = toEVMInstruction(m_dialect, _funCall.functionName.name))
+			m_costs += m_meter.instructionCosts(*instruction);
+		else if (m_dialect.builtin(_funCall.functionName.name))
+			m_costs += m_pushCosts;
+		else
+			// Pushing the return label, jumping into the function and back.
+			m_costs += m_pushCosts + 2 * m_jumpCosts;
+	}
+	void operator()(Literal const& _literal) override
+	{
+		// String literals are only arguments of builtins that replace them by their value.
+		if (_literal.kind == LiteralKind::String)
+			return;
+		m_costs += m_meter.costs(Expression{_literal});
+	}
+	void operator()(Identifier const& _identifier) override
+	{
+		m_costs += m_meter.costs(Expression{_identifier});
+	}
+	void operator()(If const& _if) override
+	{
+		m_costs += m_conditionalJumpCosts;
+		ASTWalker::operator()(_if);
+	}
+	void operator()(Switch const& _switch) override
+	{
+		m_costs += m_conditionalJumpCosts * _switch.cases.size();
+		ASTWalker::operator()(_switch);
+	}
+	void operator()(ForLoop const& _forLoop) override
+	{
+		m_costs += m_conditionalJumpCosts + m_jumpCosts;
+		ASTWalker::operator()(_forLoop);
+	}
+
+private:
+	Dialect const& m_dialect;
+	GasMeter const& m_meter;
+	bigint const m_pushCosts;
+	bigint const m_jumpCosts;
+	bigint const m_conditionalJumpCosts;
+	bigint m_costs = 0;
+};
+
+/// @returns @a _sequence with a single step removed, replaced or inserted.
+std::string vary(std::string const& _sequence, std::string const& _steps, std::mt19937& _random)
+{
+	std::vector<size_t> stepPositions;
+	for (size_t i = 0; i < _sequence.size(); ++i)
+		if (std::string(OptimiserSuite::NonStepAbbreviations).find(_sequence[i]) == std::string::npos)
+			stepPositions.emplace_back(i);
+
+	char const step = _steps[_random() % _steps.size()];
+	std::string result = _sequence;
+	switch (stepPositions.empty() ? 2 : _random() % 3)
+	{
+	case 0:
+		result.erase(stepPositions[_random() % stepPositions.size()], 1);
+		break;
+	case 1:
+		result[stepPositions[_random() % stepPositions.size()]] = step;
+		break;
+	default:
+		result.insert(_random() % (result.size() + 1), 1, step);
+		break;
+	}
+	return result;
+}
+
+}
+
+std::string OptimiserSequenceSearch::run(
+	Dialect const& _dialect,
+	GasMeter const* _meter,
+	Object const& _object,
+	bool _optimizeStackAllocation,
+	std::string const& _initialSequence,
+	std::string const& _cleanupSequence,
+	std::optional<size_t> _expectedExecutionsPerDeployment,
+	size_t _budget,
+	size_t _concurrency,
+	std::optional<size_t> _inlineBudget
+)
+{
+	yulAssert(_object.code);
+
+	// @returns the score of the code optimized with @a _sequence, or nullopt if the
+	// sequence leads to variables that cannot be reached.
+	auto optimizedScore = [&](std::string const& _sequence) -> std::optional<bigint> {
+		Object candidate = _object;
+		candidate.code = std::make_shared<Block>(std::get<Block>(ASTCopier{}(*_object.code)));
+		candidate.analysisInfo = std::make_shared<AsmAnalysisInfo>(
+			AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, candidate)
+		);
+		try
+		{
+			OptimiserSuite::run(
+				_dialect,
+				_meter,
+				candidate,
+				_optimizeStackAllocation,
+				_sequence,
+				_cleanupSequence,
+				_expectedExecutionsPerDeployment,
+				{},
+				nullptr,
+				1,
+				nullptr,
+				0,
+				_inlineBudget
+			);
+		}
+		catch (StackTooDeepError const&)
+		{
+			return std::nullopt;
+		}
+		return score(_dialect, _meter, candidate);
+	};
+
+	std::optional<bigint> bestScore = optimizedScore(_initialSequence);
+	if (!bestScore)
+		return _initialSequence;
+	std::string bestSequence = _initialSequence;
+
+	std::string steps;
+	for (auto const& [abbreviation, name]: OptimiserSuite::stepAbbreviationToNameMap())
+		if (!OptimiserSuite::allSteps().at(name)->invalidInCurrentEnvironment())
+			steps += abbreviation;
+	yulAssert(!steps.empty());
+
+	// A fixed seed makes the search reproducible.
+	std::mt19937 random{1};
+	for (size_t tried = 0; tried < _budget;)
+	{
+		size_t const count = std::min(variationsPerRound, _budget - tried);
+		std::vector<std::string> variations;
+		for (size_t i = 0; i < count; ++i)
+			variations.emplace_back(vary(bestSequence, steps, random));
+
+		std::vector<std::optional<bigint>> scores(count);
+		util::parallelFor(count, _concurrency, [&](size_t _index) {
+			scores[_index] = optimizedScore(variations[_index]);
+		});
+
+		for (size_t i = 0; i < count; ++i)
+			if (scores[i] && *scores[i] < *bestScore)
+			{
+				bestScore = scores[i];
+				bestSequence = std::move(variations[i]);
+			}
+		tried += count;
+	}
+	return bestSequence;
+}
+
+bigint OptimiserSequenceSearch::score(Dialect const& _dialect, GasMeter const* _meter, Object const& _object)
+{
+	yulAssert(_object.code);
+	if (!_meter)
+		return CodeSize::codeSizeIncludingFunctions(*_object.code);
+
+	CostEstimator estimator{_dialect, *_meter};
+	estimator(*_object.code);
+	return estimator.costs();
+}
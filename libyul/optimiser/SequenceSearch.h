@@ -0,0 +1,76 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Search for an optimiser step sequence that yields cheaper code for a particular object.
+ */
+
+#pragma once
+
+#include <libsolutil/Numeric.h>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+struct Object;
+class GasMeter;
+
+/**
+ * Searches for the main sequence of optimiser steps that results in the cheapest code for an
+ * object. Starting from a given sequence, it repeatedly tries variations of the best sequence
+ * found so far, each of which removes, replaces or inserts a single step, and keeps a variation
+ * if it results in cheaper code. The search ends after a given number of variations.
+ *
+ * The code is scored with the gas meter, i.e. by the costs of deploying it plus the costs of
+ * executing every expression once, weighted by the expected number of executions. Without a
+ * gas meter, the code size is used.
+ *
+ * The search is deterministic: The same object, settings and budget always result in the same
+ * sequence, independently of the number of threads used to evaluate the variations.
+ */
+class OptimiserSequenceSearch
+{
+public:
+	/// Number of variations that are derived from the same sequence and evaluated together.
+	static size_t constexpr variationsPerRound = 8;
+
+	/// @returns the best main sequence found after trying @a _budget variations of
+	/// @a _initialSequence. The remaining parameters are the ones of OptimiserSuite::run.
+	/// @a _object is not modified.
+	static std::string run(
+		Dialect const& _dialect,
+		GasMeter const* _meter,
+		Object const& _object,
+		bool _optimizeStackAllocation,
+		std::string const& _initialSequence,
+		std::string const& _cleanupSequence,
+		std::optional<size_t> _expectedExecutionsPerDeployment,
+		size_t _budget,
+		size_t _concurrency = 1,
+		std::optional<size_t> _inlineBudget = std::nullopt
+	);
+
+	/// @returns the score of the code of @a _object as described above. Lower is better.
+	static bigint score(Dialect const& _dialect, GasMeter const* _meter, Object const& _object);
+};
+
+}
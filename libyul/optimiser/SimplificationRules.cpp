@@ -32,6 +32,9 @@
 #include <libevmasm/RuleList.h>
 #include <libsolutil/StringUtils.h>
 
+#include <limits>
+#include <map>
+
 using namespace solidity;
 using namespace solidity::evmasm;
 using namespace solidity::langutil;
@@ -47,7 +50,8 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	if (!instruction)
 		return nullptr;
 
-	static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
+	// Matching stores the match groups inside the rule list, so every thread needs its own copy.
+	thread_local std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
 
 	std::optional<EVMVersion> version;
 	if (yul::EVMDialect const* evmDialect = dynamic_cast<yul::EVMDialect const*>(&_dialect))
@@ -59,16 +63,122 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	SimplificationRules& rules = *evmRules[version];
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
+	RuleIndex const& index = rules.m_index[uint8_t(instruction->first)];
+	if (index.candidates.empty())
+		return nullptr;
+	std::vector<Expression> const& arguments = *instruction->second;
+	yulAssert(arguments.size() == index.groups.size());
+
+	size_t combination = 0;
+	for (size_t i = 0; i < arguments.size(); ++i)
+	{
+		// Patterns never match direct function calls as arguments, see Pattern::matches.
+		if (std::holds_alternative<FunctionCall>(arguments[i]))
+			return nullptr;
+
+		// Resolve the variable like Pattern::matches does for constants and operations.
+		Expression const* value = &arguments[i];
+		if (Identifier const* identifier = std::get_if<Identifier>(value))
+			if (AssignedValue const* assignedValue = _ssaValues(identifier->name))
+				if (assignedValue->value)
+					value = assignedValue->value;
+
+		size_t argumentClass = OtherArgument;
+		Literal const* literal = std::get_if<Literal>(value);
+		if (literal && literal->kind == LiteralKind::Number)
+			argumentClass = ConstantArgument;
+		else if (auto argumentInstruction = instructionAndArguments(_dialect, *value))
+			argumentClass = operationArgument(argumentInstruction->first);
+		combination = combination * index.groupCounts[i] + index.groups[i][argumentClass];
+	}
+
+	for (Rule const* rule: index.candidates[combination])
 	{
 		rules.resetMatchGroups();
-		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
-			if (!rule.feasible || rule.feasible())
-				return &rule;
+		if (rule->pattern.matches(_expr, _dialect, _ssaValues))
+			if (!rule->feasible || rule->feasible())
+				return rule;
 	}
 	return nullptr;
 }
 
+void SimplificationRules::buildIndex()
+{
+	for (size_t instruction = 0; instruction < 256; ++instruction)
+	{
+		std::vector<Rule> const& rules = m_rules[instruction];
+		if (rules.empty())
+			continue;
+		RuleIndex& index = m_index[instruction];
+		size_t const argumentCount = rules.front().pattern.arguments().size();
+
+		// The class that represents each group of each argument.
+		std::vector<std::vector<size_t>> groupClasses(argumentCount, {OtherArgument});
+		index.groups.assign(argumentCount, {});
+		for (Rule const& rule: rules)
+		{
+			std::vector<Pattern> const& arguments = rule.pattern.arguments();
+			yulAssert(arguments.size() == argumentCount);
+			for (size_t i = 0; i < argumentCount; ++i)
+			{
+				size_t argumentClass = OtherArgument;
+				if (arguments[i].kind() == PatternKind::Constant)
+					argumentClass = ConstantArgument;
+				else if (arguments[i].kind() == PatternKind::Operation)
+					argumentClass = operationArgument(arguments[i].instruction());
+				if (argumentClass != OtherArgument && index.groups[i][argumentClass] == 0)
+				{
+					yulAssert(groupClasses[i].size() <= std::numeric_limits<uint8_t>::max());
+					index.groups[i][argumentClass] = static_cast<uint8_t>(groupClasses[i].size());
+					groupClasses[i].emplace_back(argumentClass);
+				}
+			}
+		}
+
+		size_t combinations = 1;
+		for (auto const& classes: groupClasses)
+		{
+			index.groupCounts.emplace_back(classes.size());
+			combinations *= classes.size();
+		}
+		index.candidates.resize(combinations);
+		for (size_t combination = 0; combination < combinations; ++combination)
+		{
+			// The group of each argument, decoded from the last argument to the first.
+			std::vector<size_t> argumentGroups(argumentCount);
+			size_t remainder = combination;
+			for (size_t i = argumentCount; i > 0; --i)
+			{
+				argumentGroups[i - 1] = remainder % index.groupCounts[i - 1];
+				remainder /= index.groupCounts[i - 1];
+			}
+
+			for (Rule const& rule: rules)
+			{
+				std::vector<Pattern> const& arguments = rule.pattern.arguments();
+				bool canMatch = true;
+				for (size_t i = 0; i < argumentCount && canMatch; ++i)
+				{
+					size_t const argumentClass = groupClasses[i][argumentGroups[i]];
+					switch (arguments[i].kind())
+					{
+					case PatternKind::Constant:
+						canMatch = (argumentClass == ConstantArgument);
+						break;
+					case PatternKind::Operation:
+						canMatch = (argumentClass == operationArgument(arguments[i].instruction()));
+						break;
+					case PatternKind::Any:
+						break;
+					}
+				}
+				if (canMatch)
+					index.candidates[combination].emplace_back(&rule);
+			}
+		}
+	}
+}
+
 bool SimplificationRules::isInitialized() const
 {
 	return !m_rules[uint8_t(evmasm::Instruction::ADD)].empty();
@@ -119,6 +229,7 @@ SimplificationRules::SimplificationRules(std::optional<langutil::EVMVersion> _ev
 
 	addRules(simplificationRuleList(_evmVersion, A, B, C, W, X, Y, Z));
 	assertThrow(isInitialized(), OptimizerException, "Rule list not properly initialized.");
+	buildIndex();
 }
 
 yul::Pattern::Pattern(evmasm::Instruction _instruction, std::initializer_list<Pattern> _arguments):
@@ -128,8 +239,9 @@ yul::Pattern::Pattern(evmasm::Instruction _instruction, std::initializer_list<Pa
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group, MatchGroups& _matchGroups)
 {
+	yulAssert(0 < _group && _group < _matchGroups.size());
 	m_matchGroup = _group;
 	m_matchGroups = &_matchGroups;
 }
@@ -202,7 +314,7 @@ bool Pattern::matches(
 		// on the variables and not their values.
 		// The assumption is that CSE or local value numbering has been done prior to this step.
 
-		if (m_matchGroups->count(m_matchGroup))
+		if ((*m_matchGroups)[m_matchGroup])
 		{
 			assertThrow(m_kind == PatternKind::Any, OptimizerException, "Match group repetition for non-any.");
 			Expression const* firstMatch = (*m_matchGroups)[m_matchGroup];
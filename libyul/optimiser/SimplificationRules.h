@@ -32,6 +32,8 @@
 #include <liblangutil/EVMVersion.h>
 #include <liblangutil/DebugData.h>
 
+#include <array>
+#include <cstdint>
 #include <functional>
 #include <optional>
 #include <vector>
@@ -44,8 +46,17 @@ class Pattern;
 
 using DebugData = langutil::DebugData;
 
+/// Expressions matched by the patterns of a rule, indexed by match group.
+/// Match group zero denotes patterns that are not part of a match group.
+using MatchGroups = std::array<Expression const*, 8>;
+
 /**
  * Container for all simplification rules.
+ *
+ * The rules for an instruction are narrowed down by the classes of the arguments of the expression,
+ * i.e. whether they are constants or which instruction they are a call to. The rules that can
+ * match each combination of classes are determined when the rules are added, so only those
+ * are matched in full.
  */
 class SimplificationRules
 {
@@ -78,10 +89,35 @@ private:
 	void addRules(std::vector<Rule> const& _rules);
 	void addRule(Rule const& _rule);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
-
-	std::map<unsigned, Expression const*> m_matchGroups;
+	/// Class of an argument that is anything but a constant or a call to an instruction.
+	static constexpr size_t OtherArgument = 0;
+	/// Class of an argument that is a number literal.
+	static constexpr size_t ConstantArgument = 1;
+	/// Class of an argument that is a call to @a _instruction.
+	static constexpr size_t operationArgument(evmasm::Instruction _instruction) { return 2 + size_t(_instruction); }
+	static constexpr size_t ArgumentClassCount = 2 + 256;
+
+	/// Rules of one instruction, indexed by the classes of the arguments.
+	struct RuleIndex
+	{
+		/// For each argument, the group of every argument class. Classes that no pattern of the
+		/// rules tells apart at that argument share group zero.
+		std::vector<std::array<uint8_t, ArgumentClassCount>> groups;
+		/// Number of groups of each argument.
+		std::vector<size_t> groupCounts;
+		/// For each combination of argument groups, the first argument varying slowest, the
+		/// rules in order whose top-level argument patterns can match it.
+		std::vector<std::vector<Rule const*>> candidates;
+	};
+
+	/// Builds m_index from m_rules. The rules must not change afterwards.
+	void buildIndex();
+
+	void resetMatchGroups() { m_matchGroups.fill(nullptr); }
+
+	MatchGroups m_matchGroups{};
 	std::vector<evmasm::SimplificationRule<Pattern>> m_rules[256];
+	std::array<RuleIndex, 256> m_index;
 };
 
 enum class PatternKind
@@ -116,8 +152,9 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group, MatchGroups& _matchGroups);
 	unsigned matchGroup() const { return m_matchGroup; }
+	PatternKind kind() const { return m_kind; }
 	bool matches(
 		Expression const& _expr,
 		Dialect const& _dialect,
@@ -143,7 +180,7 @@ private:
 	std::shared_ptr<u256> m_data; ///< Only valid if m_kind is Constant
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
+	MatchGroups* m_matchGroups = nullptr;
 };
 
 }
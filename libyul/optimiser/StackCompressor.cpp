@@ -239,7 +239,8 @@ bool StackCompressor::run(
 	Dialect const& _dialect,
 	Object& _object,
 	bool _optimizeStackAllocation,
-	size_t _maxIterations
+	size_t _maxIterations,
+	size_t _stackLayoutSearchEffort
 )
 {
 	yulAssert(
@@ -261,7 +262,7 @@ bool StackCompressor::run(
 		eliminateVariablesOptimizedCodegen(
 			_dialect,
 			*_object.code,
-			StackLayoutGenerator::reportStackTooDeep(*cfg),
+			StackLayoutGenerator::reportStackTooDeep(*cfg, _stackLayoutSearchEffort),
 			allowMSizeOptimization
 		);
 	}
@@ -45,12 +45,14 @@ class StackCompressor
 {
 public:
 	/// Try to remove local variables until the AST is compilable.
+	/// @a _stackLayoutSearchEffort is the effort the optimized code generator spends on the stack layouts.
 	/// @returns true if it was successful.
 	static bool run(
 		Dialect const& _dialect,
 		Object& _object,
 		bool _optimizeStackAllocation,
-		size_t _maxIterations
+		size_t _maxIterations,
+		size_t _stackLayoutSearchEffort = 0
 	);
 };
 
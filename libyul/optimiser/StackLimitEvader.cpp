@@ -131,7 +131,7 @@ void StackLimitEvader::run(
 	{
 		yul::AsmAnalysisInfo analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(*evmDialect, _object);
 		std::unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(analysisInfo, *evmDialect, *_object.code);
-		run(_context, _object, StackLayoutGenerator::reportStackTooDeep(*cfg));
+		run(_context, _object, StackLayoutGenerator::reportStackTooDeep(*cfg, _context.stackLayoutSearchEffort));
 	}
 	else
 		run(_context, _object, CompilabilityChecker{
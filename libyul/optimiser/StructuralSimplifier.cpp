@@ -80,9 +80,9 @@ bool expressionAlwaysFalse(Expression const& _expression)
 
 }
 
-void StructuralSimplifier::run(OptimiserStepContext&, Block& _ast)
+FunctionLocalTransform StructuralSimplifier::functionLocalTransform(OptimiserStepContext&, Block const&)
 {
-	StructuralSimplifier{}(_ast);
+	return [](Statement& _statement) { StructuralSimplifier{}.visit(_statement); };
 }
 
 void StructuralSimplifier::operator()(Block& _block)
@@ -37,11 +37,11 @@ namespace solidity::yul
  *
  * Important: Can only be used on EVM code.
  */
-class StructuralSimplifier: public ASTModifier
+class StructuralSimplifier: public ASTModifier, public FunctionLocalStep<StructuralSimplifier>
 {
 public:
 	static constexpr char const* name{"StructuralSimplifier"};
-	static void run(OptimiserStepContext&, Block& _ast);
+	static FunctionLocalTransform functionLocalTransform(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(Block& _block) override;
@@ -31,6 +31,7 @@
 #include <libyul/optimiser/ConditionalUnsimplifier.h>
 #include <libyul/optimiser/DeadCodeEliminator.h>
 #include <libyul/optimiser/FunctionGrouper.h>
+#include <libyul/optimiser/FunctionStepMemoizer.h>
 #include <libyul/optimiser/FunctionHoister.h>
 #include <libyul/optimiser/EqualStoreEliminator.h>
 #include <libyul/optimiser/EquivalentFunctionCombiner.h>
@@ -62,6 +63,7 @@
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/NameSimplifier.h>
+#include <libyul/optimiser/OptimiserStepProfile.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
@@ -72,6 +74,7 @@
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Parallel.h>
 
 #include <libyul/CompilabilityChecker.h>
 
@@ -80,58 +83,15 @@
 #include <range/v3/algorithm/count.hpp>
 #include <range/v3/algorithm/none_of.hpp>
 
+#include <chrono>
 #include <limits>
+#include <optional>
 #include <tuple>
 
-#ifdef PROFILE_OPTIMIZER_STEPS
-#include <chrono>
-#include <fmt/format.h>
-#endif
-
 using namespace solidity;
 using namespace solidity::yul;
-#ifdef PROFILE_OPTIMIZER_STEPS
-using namespace std::chrono;
-#endif
 using namespace std::string_literals;
 
-namespace
-{
-
-#ifdef PROFILE_OPTIMIZER_STEPS
-void outputPerformanceMetrics(map<string, int64_t> const& _metrics)
-{
-	vector<pair<string, int64_t>> durations(_metrics.begin(), _metrics.end());
-	sort(
-		durations.begin(),
-		durations.end(),
-		[](pair<string, int64_t> const& _lhs, pair<string, int64_t> const& _rhs) -> bool
-		{
-			return _lhs.second < _rhs.second;
-		}
-	);
-
-	int64_t totalDurationInMicroseconds = 0;
-	for (auto&& [step, durationInMicroseconds]: durations)
-		totalDurationInMicroseconds += durationInMicroseconds;
-
-	cerr << "Performance metrics of optimizer steps" << endl;
-	cerr << "======================================" << endl;
-	constexpr double microsecondsInSecond = 1000000;
-	for (auto&& [step, durationInMicroseconds]: durations)
-	{
-		double percentage = 100.0 * static_cast<double>(durationInMicroseconds) / static_cast<double>(totalDurationInMicroseconds);
-		double sec = static_cast<double>(durationInMicroseconds) / microsecondsInSecond;
-		cerr << fmt::format("{:>7.3f}% ({} s): {}", percentage, sec, step) << endl;
-	}
-	double totalDurationInSeconds = static_cast<double>(totalDurationInMicroseconds) / microsecondsInSecond;
-	cerr << "--------------------------------------" << endl;
-	cerr << fmt::format("{:>7}% ({:.3f} s)", 100, totalDurationInSeconds) << endl;
-}
-#endif
-
-}
-
 
 void OptimiserSuite::run(
 	Dialect const& _dialect,
@@ -141,7 +101,12 @@ void OptimiserSuite::run(
 	std::string_view _optimisationSequence,
 	std::string_view _optimisationCleanupSequence,
 	std::optional<size_t> _expectedExecutionsPerDeployment,
-	std::set<YulString> const& _externallyUsedIdentifiers
+	std::set<YulString> const& _externallyUsedIdentifiers,
+	OptimiserStepProfile* _profile,
+	size_t _concurrency,
+	OptimizedCodeCache* _functionCache,
+	size_t _stackLayoutSearchEffort,
+	std::optional<size_t> _inlineBudget
 )
 {
 	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect);
@@ -162,8 +127,16 @@ void OptimiserSuite::run(
 
 	NameDispenser dispenser{_dialect, ast, reservedIdentifiers};
 	OptimiserStepContext context{_dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment};
+	context.stackLayoutSearchEffort = _stackLayoutSearchEffort;
+	// A single budget for all runs of the FullInliner, so that repeating it does not
+	// multiply the code size.
+	context.inlineBudget = _inlineBudget;
 
 	OptimiserSuite suite(context, Debug::None);
+	suite.m_profile = _profile;
+	suite.m_objectName = _object.name;
+	suite.m_concurrency = _concurrency;
+	suite.m_functionCache = _functionCache;
 
 	// Some steps depend on properties ensured by FunctionHoister, BlockFlattener, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
@@ -204,7 +177,8 @@ void OptimiserSuite::run(
 				_dialect,
 				_object,
 				_optimizeStackAllocation,
-				stackCompressorMaxIterations
+				stackCompressorMaxIterations,
+				_stackLayoutSearchEffort
 			);
 			if (evmDialect->providesObjectAccess())
 				StackLimitEvader::run(suite.m_context, _object);
@@ -217,10 +191,6 @@ void OptimiserSuite::run(
 	NameSimplifier::run(suite.m_context, ast);
 	VarNameCleaner::run(suite.m_context, ast);
 
-#ifdef PROFILE_OPTIMIZER_STEPS
-	outputPerformanceMetrics(suite.m_durationPerStepInMicroseconds);
-#endif
-
 	*_object.analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
 }
 
@@ -245,42 +215,40 @@ std::map<std::string, std::unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 std::map<std::string, std::unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static std::map<std::string, std::unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EqualStoreEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			FunctionSpecializer,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			UnusedAssignEliminator,
-			UnusedStoreEliminator,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	static std::map<std::string, std::unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EqualStoreEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGrouper,
+		FunctionHoister,
+		FunctionSpecializer,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		UnusedAssignEliminator,
+		UnusedStoreEliminator,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
 	return instance;
@@ -465,8 +433,11 @@ void OptimiserSuite::runSequence(std::string_view _stepAbbreviations, Block& _as
 	// NOTE: If _repeatUntilStable is false, the value will not be used so do not calculate it.
 	size_t codeSize = (_repeatUntilStable ? CodeSize::codeSizeIncludingFunctions(_ast) : 0);
 
+	size_t const outerRound = m_round;
 	for (size_t round = 0; round < MaxRounds; ++round)
 	{
+		if (_repeatUntilStable)
+			m_round = round + 1;
 		for (auto const& [subsequence, repeat]: subsequences)
 		{
 			if (repeat)
@@ -483,6 +454,7 @@ void OptimiserSuite::runSequence(std::string_view _stepAbbreviations, Block& _as
 			break;
 		codeSize = newSize;
 	}
+	m_round = outerRound;
 }
 
 void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block& _ast)
@@ -494,14 +466,21 @@ void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block&
 	{
 		if (m_debug == Debug::PrintStep)
 			std::cout << "Running " << step << std::endl;
-#ifdef PROFILE_OPTIMIZER_STEPS
-		steady_clock::time_point startTime = steady_clock::now();
-#endif
-		allSteps().at(step)->run(m_context, _ast);
-#ifdef PROFILE_OPTIMIZER_STEPS
-		steady_clock::time_point endTime = steady_clock::now();
-		m_durationPerStepInMicroseconds[step] += duration_cast<microseconds>(endTime - startTime).count();
-#endif
+		if (m_profile)
+		{
+			OptimiserStepProfile::StepRun run;
+			run.step = step;
+			run.object = m_objectName;
+			run.round = m_round;
+			run.codeSizeBefore = CodeSize::codeSizeIncludingFunctions(_ast);
+			auto const startTime = std::chrono::steady_clock::now();
+			runStep(*allSteps().at(step), _ast);
+			run.duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+			run.codeSizeAfter = CodeSize::codeSizeIncludingFunctions(_ast);
+			m_profile->record(std::move(run));
+		}
+		else
+			runStep(*allSteps().at(step), _ast);
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
@@ -516,3 +495,31 @@ void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block&
 		}
 	}
 }
+
+void OptimiserSuite::runStep(OptimiserStep const& _step, Block& _ast)
+{
+	// Grouped code consists of one block of instructions followed by the function definitions.
+	// Function-local steps can process each of them independently, based on information about
+	// the whole code that is collected beforehand, just like it is when running them sequentially.
+	if (
+		!_step.isFunctionLocal() ||
+		m_concurrency <= 1 ||
+		_ast.statements.size() <= 1 ||
+		!FunctionGrouper::alreadyGrouped(_ast)
+	)
+	{
+		_step.run(m_context, _ast);
+		return;
+	}
+
+	FunctionLocalTransform const transform = _step.functionLocalTransform(m_context, _ast);
+	std::optional<FunctionStepMemoizer> memoizer;
+	if (m_functionCache && FunctionStepMemoizer::memoizes(_step))
+		memoizer.emplace(*m_functionCache, m_context.dialect);
+	util::parallelFor(_ast.statements.size(), m_concurrency, [&](size_t _index) {
+		if (memoizer)
+			memoizer->apply(_step, transform, _ast.statements[_index]);
+		else
+			transform(_ast.statements[_index]);
+	});
+}
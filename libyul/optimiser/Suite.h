@@ -31,6 +31,7 @@
 #include <string>
 #include <string_view>
 #include <memory>
+#include <optional>
 
 namespace solidity::yul
 {
@@ -39,6 +40,8 @@ struct AsmAnalysisInfo;
 struct Dialect;
 class GasMeter;
 struct Object;
+class OptimizedCodeCache;
+class OptimiserStepProfile;
 
 /**
  * Optimiser suite that combines all steps and also provides the settings for the heuristics.
@@ -62,6 +65,15 @@ public:
 	OptimiserSuite(OptimiserStepContext& _context, Debug _debug = Debug::None): m_context(_context), m_debug(_debug) {}
 
 	/// The value nullopt for `_expectedExecutionsPerDeployment` represents creation code.
+	/// If @a _profile is given, every step run on the object is recorded in it.
+	/// Function-local steps process the functions of the object on up to @a _concurrency
+	/// threads. The result does not depend on the number of threads.
+	/// When they run on several threads, the results of steps that only depend on the function
+	/// they transform are memoized in @a _functionCache, so that it can be shared between objects.
+	/// Nothing is memoized if it is null.
+	/// @a _stackLayoutSearchEffort is the effort the code generator will spend on the stack layouts.
+	/// @a _inlineBudget is the code size all runs of the FullInliner together may add. The value
+	/// nullopt does not limit the FullInliner.
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
@@ -70,7 +82,12 @@ public:
 		std::string_view _optimisationSequence,
 		std::string_view _optimisationCleanupSequence,
 		std::optional<size_t> _expectedExecutionsPerDeployment,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		OptimiserStepProfile* _profile = nullptr,
+		size_t _concurrency = 1,
+		OptimizedCodeCache* _functionCache = nullptr,
+		size_t _stackLayoutSearchEffort = 0,
+		std::optional<size_t> _inlineBudget = std::nullopt
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -89,11 +106,21 @@ public:
 	static std::map<char, std::string> const& stepAbbreviationToNameMap();
 
 private:
+	/// Runs @a _step on @a _ast. Function-local steps are run on the top-level statements
+	/// of grouped code concurrently if more than one thread is allowed.
+	void runStep(OptimiserStep const& _step, Block& _ast);
+
 	OptimiserStepContext& m_context;
 	Debug m_debug;
-#ifdef PROFILE_OPTIMIZER_STEPS
-	std::map<std::string, int64_t> m_durationPerStepInMicroseconds;
-#endif
+	OptimiserStepProfile* m_profile = nullptr;
+	/// Name of the object being optimized, only used for the profile.
+	std::string m_objectName;
+	/// Iteration of the innermost repeated subsequence being run, only used for the profile.
+	size_t m_round = 0;
+	/// Maximum number of threads used by function-local steps.
+	size_t m_concurrency = 1;
+	/// Results of context-free function-local steps on single function definitions.
+	OptimizedCodeCache* m_functionCache = nullptr;
 };
 
 }
@@ -37,19 +37,21 @@
 using namespace solidity;
 using namespace solidity::yul;
 
-void UnusedAssignEliminator::run(OptimiserStepContext& _context, Block& _ast)
+FunctionLocalTransform UnusedAssignEliminator::functionLocalTransform(OptimiserStepContext& _context, Block const& _ast)
 {
-	UnusedAssignEliminator uae{
-		_context.dialect,
+	auto controlFlowSideEffects = std::make_shared<std::map<YulString, ControlFlowSideEffects> const>(
 		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
-	};
-	uae(_ast);
+	);
+	return [&dialect = _context.dialect, controlFlowSideEffects](Statement& _statement) {
+		UnusedAssignEliminator uae{dialect, *controlFlowSideEffects};
+		uae.visit(_statement);
 
-	uae.m_storesToRemove += uae.m_allStores - uae.m_usedStores;
+		uae.collectUnusedStores();
 
-	std::set<Statement const*> toRemove{uae.m_storesToRemove.begin(), uae.m_storesToRemove.end()};
-	StatementRemover remover{toRemove};
-	remover(_ast);
+		std::set<Statement const*> toRemove{uae.m_storesToRemove.begin(), uae.m_storesToRemove.end()};
+		StatementRemover remover{toRemove};
+		remover.visit(_statement);
+	};
 }
 
 void UnusedAssignEliminator::operator()(Identifier const& _identifier)
@@ -117,9 +119,9 @@ void UnusedAssignEliminator::visit(Statement const& _statement)
 		// but clear the active stores to the assigned variables in any case.
 		if (SideEffectsCollector{m_dialect, *assignment->value}.movable())
 		{
-			m_allStores.insert(&_statement);
+			size_t const store = addStore(_statement);
 			for (auto const& var: assignment->variableNames)
-				m_activeStores[var.name] = {&_statement};
+				m_activeStores[var.name] = StoreSet{store};
 		}
 		else
 			for (auto const& var: assignment->variableNames)
@@ -134,15 +136,12 @@ void UnusedAssignEliminator::shortcutNestedLoop(ActiveStores const& _zeroRuns)
 	// We do not have to do that with the "break" or "continue" paths, because
 	// they will be joined later anyway.
 
-	for (auto& [variable, stores]: m_activeStores)
+	for (auto const& [variable, stores]: m_activeStores)
 	{
-		auto zeroIt = _zeroRuns.find(variable);
-		for (auto& assignment: stores)
-		{
-			if (zeroIt != _zeroRuns.end() && zeroIt->second.count(assignment))
-				continue;
-			m_usedStores.insert(assignment);
-		}
+		StoreSet newStores = stores;
+		if (auto zeroIt = _zeroRuns.find(variable); zeroIt != _zeroRuns.end())
+			newStores -= zeroIt->second;
+		markStoresUsed(newStores);
 	}
 }
 
@@ -154,7 +153,9 @@ void UnusedAssignEliminator::finalizeFunctionDefinition(FunctionDefinition const
 
 void UnusedAssignEliminator::markUsed(YulString _variable)
 {
-	for (auto& assignment: m_activeStores[_variable])
-		m_usedStores.insert(assignment);
-	m_activeStores.erase(_variable);
+	if (auto it = m_activeStores.find(_variable); it != m_activeStores.end())
+	{
+		markStoresUsed(it->second);
+		m_activeStores.erase(it);
+	}
 }
@@ -113,15 +113,15 @@ struct Dialect;
  *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
-class UnusedAssignEliminator: public UnusedStoreBase
+class UnusedAssignEliminator: public UnusedStoreBase, public FunctionLocalStep<UnusedAssignEliminator>
 {
 public:
 	static constexpr char const* name{"UnusedAssignEliminator"};
-	static void run(OptimiserStepContext&, Block& _ast);
+	static FunctionLocalTransform functionLocalTransform(OptimiserStepContext&, Block const& _ast);
 
 	explicit UnusedAssignEliminator(
 		Dialect const& _dialect,
-		std::map<YulString, ControlFlowSideEffects> _controlFlowSideEffects
+		std::map<YulString, ControlFlowSideEffects> const& _controlFlowSideEffects
 	):
 		UnusedStoreBase(_dialect),
 		m_controlFlowSideEffects(_controlFlowSideEffects)
@@ -144,7 +144,7 @@ private:
 	void markUsed(YulString _variable);
 
 	std::set<YulString> m_returnVariables;
-	std::map<YulString, ControlFlowSideEffects> m_controlFlowSideEffects;
+	std::map<YulString, ControlFlowSideEffects> const& m_controlFlowSideEffects;
 };
 
 }
@@ -29,6 +29,9 @@
 
 #include <range/v3/action/remove_if.hpp>
 
+#include <algorithm>
+#include <iterator>
+
 using namespace solidity;
 using namespace solidity::yul;
 
@@ -70,7 +73,8 @@ void UnusedStoreBase::operator()(Switch const& _switch)
 
 void UnusedStoreBase::operator()(FunctionDefinition const& _functionDefinition)
 {
-	ScopedSaveAndRestore allStores(m_allStores, {});
+	ScopedSaveAndRestore stores(m_stores, {});
+	ScopedSaveAndRestore storeIndices(m_storeIndices, {});
 	ScopedSaveAndRestore usedStores(m_usedStores, {});
 	ScopedSaveAndRestore outerAssignments(m_activeStores, {});
 	ScopedSaveAndRestore forLoopInfo(m_forLoopInfo, {});
@@ -79,7 +83,7 @@ void UnusedStoreBase::operator()(FunctionDefinition const& _functionDefinition)
 	(*this)(_functionDefinition.body);
 
 	finalizeFunctionDefinition(_functionDefinition);
-	m_storesToRemove += m_allStores - m_usedStores;
+	collectUnusedStores();
 }
 
 void UnusedStoreBase::operator()(ForLoop const& _forLoop)
@@ -144,12 +148,9 @@ void UnusedStoreBase::operator()(Continue const&)
 
 void UnusedStoreBase::merge(ActiveStores& _target, ActiveStores&& _other)
 {
-	util::joinMap(_target, std::move(_other), [](
-		std::set<Statement const*>& _storesHere,
-		std::set<Statement const*>&& _storesThere
-	)
+	util::joinMap(_target, std::move(_other), [](StoreSet& _storesHere, StoreSet&& _storesThere)
 	{
-		_storesHere += _storesThere;
+		_storesHere |= _storesThere;
 	});
 }
 
@@ -159,3 +160,130 @@ void UnusedStoreBase::merge(ActiveStores& _target, std::vector<ActiveStores>&& _
 		merge(_target, std::move(ts));
 	_source.clear();
 }
+
+size_t UnusedStoreBase::addStore(Statement const& _store)
+{
+	auto [it, inserted] = m_storeIndices.emplace(&_store, m_stores.size());
+	if (inserted)
+		m_stores.emplace_back(&_store);
+	return it->second;
+}
+
+void UnusedStoreBase::collectUnusedStores()
+{
+	for (size_t index = 0; index < m_stores.size(); ++index)
+		if (!m_usedStores.contains(index))
+			m_storesToRemove.emplace_back(m_stores[index]);
+}
+
+void UnusedStoreBase::StoreSet::insert(size_t _index)
+{
+	if (m_dense)
+	{
+		setBit(_index);
+		return;
+	}
+	auto it = std::lower_bound(m_indices.begin(), m_indices.end(), _index);
+	if (it != m_indices.end() && *it == _index)
+		return;
+	m_indices.insert(it, _index);
+	if (m_indices.size() > SparseLimit)
+		makeDense();
+}
+
+void UnusedStoreBase::StoreSet::erase(size_t _index)
+{
+	if (!m_dense)
+	{
+		auto it = std::lower_bound(m_indices.begin(), m_indices.end(), _index);
+		if (it != m_indices.end() && *it == _index)
+			m_indices.erase(it);
+	}
+	else if (_index / 64 < m_words.size())
+		m_words[_index / 64] &= ~(uint64_t(1) << (_index % 64));
+}
+
+bool UnusedStoreBase::StoreSet::contains(size_t _index) const
+{
+	if (!m_dense)
+		return std::binary_search(m_indices.begin(), m_indices.end(), _index);
+	return _index / 64 < m_words.size() && (m_words[_index / 64] & (uint64_t(1) << (_index % 64)));
+}
+
+bool UnusedStoreBase::StoreSet::empty() const
+{
+	if (!m_dense)
+		return m_indices.empty();
+	for (uint64_t word: m_words)
+		if (word != 0)
+			return false;
+	return true;
+}
+
+void UnusedStoreBase::StoreSet::clear()
+{
+	m_dense = false;
+	m_indices.clear();
+	m_words.clear();
+}
+
+UnusedStoreBase::StoreSet& UnusedStoreBase::StoreSet::operator|=(StoreSet const& _other)
+{
+	if (!m_dense && !_other.m_dense)
+	{
+		std::vector<size_t> indices;
+		indices.reserve(m_indices.size() + _other.m_indices.size());
+		std::set_union(
+			m_indices.begin(), m_indices.end(),
+			_other.m_indices.begin(), _other.m_indices.end(),
+			std::back_inserter(indices)
+		);
+		m_indices = std::move(indices);
+		if (m_indices.size() > SparseLimit)
+			makeDense();
+		return *this;
+	}
+
+	makeDense();
+	if (!_other.m_dense)
+		for (size_t index: _other.m_indices)
+			setBit(index);
+	else
+	{
+		if (_other.m_words.size() > m_words.size())
+			m_words.resize(_other.m_words.size(), 0);
+		for (size_t i = 0; i < _other.m_words.size(); ++i)
+			m_words[i] |= _other.m_words[i];
+	}
+	return *this;
+}
+
+UnusedStoreBase::StoreSet& UnusedStoreBase::StoreSet::operator-=(StoreSet const& _other)
+{
+	if (!m_dense)
+		ranges::actions::remove_if(m_indices, [&](size_t _index) { return _other.contains(_index); });
+	else if (!_other.m_dense)
+		for (size_t index: _other.m_indices)
+			erase(index);
+	else
+		for (size_t i = 0; i < std::min(m_words.size(), _other.m_words.size()); ++i)
+			m_words[i] &= ~_other.m_words[i];
+	return *this;
+}
+
+void UnusedStoreBase::StoreSet::makeDense()
+{
+	if (m_dense)
+		return;
+	m_dense = true;
+	for (size_t index: m_indices)
+		setBit(index);
+	m_indices.clear();
+}
+
+void UnusedStoreBase::StoreSet::setBit(size_t _index)
+{
+	if (_index / 64 >= m_words.size())
+		m_words.resize(_index / 64 + 1, 0);
+	m_words[_index / 64] |= uint64_t(1) << (_index % 64);
+}
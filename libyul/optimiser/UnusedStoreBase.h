@@ -26,7 +26,10 @@
 
 #include <range/v3/action/remove_if.hpp>
 
+#include <cstdint>
+#include <unordered_map>
 #include <variant>
+#include <vector>
 
 
 namespace solidity::yul
@@ -44,6 +47,9 @@ struct Dialect;
  * or not. Those are split and joined at control-flow forks. Once a store has been deemed
  * used, it is removed from the active set and marked as used and this will never change.
  *
+ * Stores are numbered densely per function. Small sets of stores are kept as sorted lists
+ * of indices, larger ones as bitsets that are split and joined with a few word operations.
+ *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
 class UnusedStoreBase: public ASTWalker
@@ -60,7 +66,56 @@ public:
 	void operator()(Continue const&) override;
 
 protected:
-	using ActiveStores = std::map<YulString, std::set<Statement const*>>;
+	/// Set of stores of the current function, represented by the sorted indices of the stores
+	/// as long as it is small and as a bitset over the indices once it grows beyond SparseLimit.
+	class StoreSet
+	{
+	public:
+		StoreSet() = default;
+		explicit StoreSet(size_t _index) { insert(_index); }
+
+		void insert(size_t _index);
+		void erase(size_t _index);
+		bool contains(size_t _index) const;
+		bool empty() const;
+		void clear();
+
+		StoreSet& operator|=(StoreSet const& _other);
+		StoreSet& operator-=(StoreSet const& _other);
+
+		/// Calls @a _callback with the index of every store in the set, in increasing order.
+		template <typename Callback>
+		void forEach(Callback&& _callback) const
+		{
+			if (!m_dense)
+			{
+				for (size_t index: m_indices)
+					_callback(index);
+				return;
+			}
+			for (size_t word = 0; word < m_words.size(); ++word)
+			{
+				uint64_t bits = m_words[word];
+				for (size_t bit = 0; bits != 0; bits >>= 1, ++bit)
+					if (bits & 1)
+						_callback(word * 64 + bit);
+			}
+		}
+
+	private:
+		/// Number of indices above which the set switches to the bitset.
+		static constexpr size_t SparseLimit = 16;
+
+		/// Converts the set to the bitset representation.
+		void makeDense();
+		void setBit(size_t _index);
+
+		/// If true, the set is stored in m_words, otherwise in m_indices.
+		bool m_dense = false;
+		std::vector<size_t> m_indices;
+		std::vector<uint64_t> m_words;
+	};
+	using ActiveStores = std::map<YulString, StoreSet>;
 
 	/// This function is called for a loop that is nested too deep to avoid
 	/// horrible runtime and should just resolve the situation in a pragmatic
@@ -76,11 +131,20 @@ protected:
 	static void merge(ActiveStores& _target, ActiveStores&& _source);
 	static void merge(ActiveStores& _target, std::vector<ActiveStores>&& _source);
 
+	/// Registers @a _store as a store of the current function.
+	/// @returns the index of the store, which does not change if the statement is visited again.
+	size_t addStore(Statement const& _store);
+	/// Marks all stores in @a _stores as used.
+	void markStoresUsed(StoreSet const& _stores) { m_usedStores |= _stores; }
+	/// Adds all stores of the current function that are not marked as used to m_storesToRemove.
+	void collectUnusedStores();
+
 	Dialect const& m_dialect;
-	/// Set of all stores encountered during the traversal (in the current function).
-	std::set<Statement const*> m_allStores;
+	/// All stores encountered during the traversal (in the current function), by index.
+	std::vector<Statement const*> m_stores;
+	std::unordered_map<Statement const*, size_t> m_storeIndices;
 	/// Set of stores that are marked as being used (in the current function).
-	std::set<Statement const*> m_usedStores;
+	StoreSet m_usedStores;
 	/// List of stores that can be removed (globally).
 	std::vector<Statement const*> m_storesToRemove;
 	/// Active (undecided) stores in the current branch.
@@ -84,7 +84,7 @@ void UnusedStoreEliminator::run(OptimiserStepContext& _context, Block& _ast)
 	else
 		rse.markActiveAsUsed(Location::Memory);
 	rse.markActiveAsUsed(Location::Storage);
-	rse.m_storesToRemove += rse.m_allStores - rse.m_usedStores;
+	rse.collectUnusedStores();
 
 	std::set<Statement const*> toRemove{rse.m_storesToRemove.begin(), rse.m_storesToRemove.end()};
 	StatementRemover remover{toRemove};
@@ -208,17 +208,18 @@ void UnusedStoreEliminator::visit(Statement const& _statement)
 			if (!allowReturndatacopyToBeRemoved)
 				return;
 		}
-		m_allStores.insert(&_statement);
+		size_t const store = addStore(_statement);
 		std::vector<Operation> operations = operationsFromFunctionCall(*funCall);
 		yulAssert(operations.size() == 1, "");
 		if (operations.front().location == Location::Storage)
-			activeStorageStores().insert(&_statement);
+			activeStorageStores().insert(store);
 		else
 		{
 			yulAssert(operations.front().location == Location::Memory, "");
-			activeMemoryStores().insert(&_statement);
+			activeMemoryStores().insert(store);
 		}
-		m_storeOperations[&_statement] = std::move(operations.front());
+		if (store == m_storeOperations.size())
+			m_storeOperations.emplace_back(std::move(operations.front()));
 	}
 }
 
@@ -274,28 +275,27 @@ std::vector<UnusedStoreEliminator::Operation> UnusedStoreEliminator::operationsF
 
 void UnusedStoreEliminator::applyOperation(UnusedStoreEliminator::Operation const& _operation)
 {
-	std::set<Statement const*>& active =
+	StoreSet& active =
 		_operation.location == Location::Storage ?
 		activeStorageStores() :
 		activeMemoryStores();
 
-
-	for (auto it = active.begin(); it != active.end();)
-	{
-		Statement const* statement = *it;
-		Operation const& storeOperation = m_storeOperations.at(statement);
+	StoreSet read;
+	StoreSet decided;
+	active.forEach([&](size_t _store) {
+		Operation const& storeOperation = m_storeOperations.at(_store);
 		if (_operation.effect == Effect::Read && !knownUnrelated(storeOperation, _operation))
 		{
 			// This store is read from, mark it as used and remove it from the active set.
-			m_usedStores.insert(statement);
-			it = active.erase(it);
+			read.insert(_store);
+			decided.insert(_store);
 		}
 		else if (_operation.effect == Effect::Write && knownCovered(storeOperation, _operation))
 			// This store is overwritten before being read, remove it from the active set.
-			it = active.erase(it);
-		else
-			++it;
-	}
+			decided.insert(_store);
+	});
+	markStoresUsed(read);
+	active -= decided;
 }
 
 bool UnusedStoreEliminator::knownUnrelated(
@@ -417,11 +417,9 @@ void UnusedStoreEliminator::markActiveAsUsed(
 )
 {
 	if (_onlyLocation == std::nullopt || _onlyLocation == Location::Memory)
-		for (Statement const* statement: activeMemoryStores())
-			m_usedStores.insert(statement);
+		markStoresUsed(activeMemoryStores());
 	if (_onlyLocation == std::nullopt || _onlyLocation == Location::Storage)
-		for (Statement const* statement: activeStorageStores())
-			m_usedStores.insert(statement);
+		markStoresUsed(activeStorageStores());
 	clearActive(_onlyLocation);
 }
 
@@ -92,8 +92,8 @@ public:
 	};
 
 private:
-	std::set<Statement const*>& activeMemoryStores() { return m_activeStores["m"_yulstring]; }
-	std::set<Statement const*>& activeStorageStores() { return m_activeStores["s"_yulstring]; }
+	StoreSet& activeMemoryStores() { return m_activeStores["m"_yulstring]; }
+	StoreSet& activeStorageStores() { return m_activeStores["s"_yulstring]; }
 
 	void shortcutNestedLoop(ActiveStores const&) override
 	{
@@ -120,7 +120,8 @@ private:
 	std::map<YulString, ControlFlowSideEffects> m_controlFlowSideEffects;
 	std::map<YulString, AssignedValue> const& m_ssaValues;
 
-	std::map<Statement const*, Operation> m_storeOperations;
+	/// Operations of the stores of the current function, by store index.
+	std::vector<Operation> m_storeOperations;
 
 	KnowledgeBase mutable m_knowledgeBase;
 };
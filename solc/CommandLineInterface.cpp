@@ -463,6 +463,43 @@ void CommandLineInterface::handleNatspec(bool _natspecDev, std::string const& _c
 	}
 }
 
+void CommandLineInterface::handleTimeReport()
+{
+	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
+
+	if (!m_options.compiler.timeReport)
+		return;
+
+	util::TimeReport const* timeReport = m_compiler->timeReport();
+	solAssert(timeReport);
+	if (!m_options.output.dir.empty())
+		createFile("time_report.json", jsonPrint(timeReport->chromeTrace(), m_options.formatting.json));
+	else
+		sout() << std::endl << "Time report:" << std::endl << timeReport->format();
+}
+
+void CommandLineInterface::handleYulOptimizerProfile()
+{
+	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
+
+	if (!m_options.optimizer.yulStepProfile || m_options.output.stopAfter < CompilerStack::State::CompilationSuccessful)
+		return;
+
+	Json profiles = Json::object();
+	for (std::string const& contract: m_compiler->contractNames())
+	{
+		Json profile = m_compiler->optimiserStepProfile(contract);
+		if (!profile.is_null())
+			profiles[contract] = std::move(profile);
+	}
+
+	std::string data = jsonPrint(profiles, m_options.formatting.json);
+	if (!m_options.output.dir.empty())
+		createFile("yul_optimizer_profile.json", data);
+	else
+		sout() << std::endl << "Yul optimizer profile:" << std::endl << data << std::endl;
+}
+
 void CommandLineInterface::handleGasEstimation(std::string const& _contract)
 {
 	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
@@ -754,6 +791,8 @@ void CommandLineInterface::processInput()
 		solAssert(m_standardJsonInput.has_value());
 
 		StandardCompiler compiler(m_universalCallback.callback(), m_options.formatting.json);
+		if (m_options.output.cacheDir.has_value())
+			compiler.setCacheDirectory(m_options.output.cacheDir.value());
 		sout() << compiler.compile(std::move(m_standardJsonInput.value())) << std::endl;
 		m_standardJsonInput.reset();
 		break;
@@ -844,9 +883,13 @@ void CommandLineInterface::compile()
 		m_compiler->setRemappings(m_options.input.remappings);
 		m_compiler->setLibraries(m_options.linker.libraries);
 		m_compiler->setViaIR(m_options.output.viaIR);
+		m_compiler->setParallelism(m_options.output.parallelism);
+		m_compiler->enableTimeReport(m_options.compiler.timeReport);
+		m_compiler->enableOptimiserStepProfile(m_options.optimizer.yulStepProfile);
 		m_compiler->setEVMVersion(m_options.output.evmVersion);
 		m_compiler->setEOFVersion(m_options.output.eofVersion);
 		m_compiler->setRevertStringBehaviour(m_options.output.revertStrings);
+		m_compiler->setGasEstimationEngine(m_options.compiler.gasEstimationEngine);
 		if (m_options.output.debugInfoSelection.has_value())
 			m_compiler->selectDebugInfo(m_options.output.debugInfoSelection.value());
 		// TODO: Perhaps we should not compile unless requested
@@ -1192,6 +1235,10 @@ void CommandLineInterface::assembleYul(yul::YulStack::Language _language, yul::Y
 				DebugInfoSelection::Default()
 		);
 
+		if (m_options.optimizer.yulStepProfile)
+			stack.setOptimiserStepProfile(std::make_shared<yul::OptimiserStepProfile>());
+		stack.setConcurrency(m_options.output.parallelism);
+
 		if (!stack.parseAndAnalyze(src.first, src.second))
 			successful = false;
 		else
@@ -1234,6 +1281,12 @@ void CommandLineInterface::assembleYul(yul::YulStack::Language _language, yul::Y
 			sout() << stack.print() << std::endl;
 		}
 
+		if (m_options.optimizer.yulStepProfile)
+		{
+			sout() << std::endl << "Yul optimizer profile:" << std::endl;
+			sout() << util::jsonPrint(stack.optimiserStepProfile()->toJson(), m_options.formatting.json) << std::endl;
+		}
+
 		yul::MachineAssemblyObject object;
 		object = stack.assemble(_targetMachine);
 		object.bytecode->link(m_options.linker.libraries);
@@ -1304,6 +1357,9 @@ void CommandLineInterface::outputCompilationResults()
 		} // end of contracts iteration
 	}
 
+	handleYulOptimizerProfile();
+	handleTimeReport();
+
 	if (!m_hasOutput)
 	{
 		if (!m_options.output.dir.empty())
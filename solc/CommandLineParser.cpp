@@ -42,6 +42,7 @@ namespace solidity::frontend
 
 static std::string const g_strAllowPaths = "allow-paths";
 static std::string const g_strBasePath = "base-path";
+static std::string const g_strCacheDir = "cache-dir";
 static std::string const g_strIncludePath = "include-path";
 static std::string const g_strAssemble = "assemble";
 static std::string const g_strCombinedJson = "combined-json";
@@ -51,10 +52,12 @@ static std::string const g_strEOFVersion = "experimental-eof-version";
 static std::string const g_strViaIR = "via-ir";
 static std::string const g_strExperimentalViaIR = "experimental-via-ir";
 static std::string const g_strGas = "gas";
+static std::string const g_strGasEstimationEngine = "gas-estimation-engine";
 static std::string const g_strHelp = "help";
 static std::string const g_strImportAst = "import-ast";
 static std::string const g_strImportEvmAssemblerJson = "import-asm-json";
 static std::string const g_strInputFile = "input-file";
+static std::string const g_strJobs = "jobs";
 static std::string const g_strYul = "yul";
 static std::string const g_strYulDialect = "yul-dialect";
 static std::string const g_strDebugInfo = "debug-info";
@@ -85,8 +88,12 @@ static std::string const g_strNoOptimizeYul = "no-optimize-yul";
 static std::string const g_strNoImportCallback = "no-import-callback";
 static std::string const g_strOptimize = "optimize";
 static std::string const g_strOptimizeRuns = "optimize-runs";
+static std::string const g_strOptimizeSearch = "optimize-search";
+static std::string const g_strOptimizeStackLayoutSearch = "optimize-stack-layout-search";
 static std::string const g_strOptimizeYul = "optimize-yul";
+static std::string const g_strYulInlineBudget = "yul-inline-budget";
 static std::string const g_strYulOptimizations = "yul-optimizations";
+static std::string const g_strYulOptimizerProfile = "yul-optimizer-profile";
 static std::string const g_strOutputDir = "output-dir";
 static std::string const g_strOverwrite = "overwrite";
 static std::string const g_strRevertStrings = "revert-strings";
@@ -102,11 +109,19 @@ static std::set<std::string> const g_revertStringsArgs
 	revertStringsToString(RevertStrings::VerboseDebug)
 };
 
+/// Possible arguments to for --gas-estimation-engine
+static std::set<std::string> const g_gasEstimationEngineArgs
+{
+	gasEstimationEngineToString(GasEstimationEngine::Path),
+	gasEstimationEngineToString(GasEstimationEngine::Dataflow)
+};
+
 static std::string const g_strSources = "sources";
 static std::string const g_strSourceList = "sourceList";
 static std::string const g_strStandardJSON = "standard-json";
 static std::string const g_strStrictAssembly = "strict-assembly";
 static std::string const g_strSwarm = "swarm";
+static std::string const g_strTimeReport = "time-report";
 static std::string const g_strPrettyJson = "pretty-json";
 static std::string const g_strJsonIndent = "json-indent";
 static std::string const g_strVersion = "version";
@@ -232,9 +247,11 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		input.ignoreMissingFiles == _other.input.ignoreMissingFiles &&
 		input.noImportCallback == _other.input.noImportCallback &&
 		output.dir == _other.output.dir &&
+		output.cacheDir == _other.output.cacheDir &&
 		output.overwriteFiles == _other.output.overwriteFiles &&
 		output.evmVersion == _other.output.evmVersion &&
 		output.viaIR == _other.output.viaIR &&
+		output.parallelism == _other.output.parallelism &&
 		output.revertStrings == _other.output.revertStrings &&
 		output.debugInfoSelection == _other.output.debugInfoSelection &&
 		output.stopAfter == _other.output.stopAfter &&
@@ -248,6 +265,8 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		formatting.withErrorIds == _other.formatting.withErrorIds &&
 		compiler.outputs == _other.compiler.outputs &&
 		compiler.estimateGas == _other.compiler.estimateGas &&
+		compiler.gasEstimationEngine == _other.compiler.gasEstimationEngine &&
+		compiler.timeReport == _other.compiler.timeReport &&
 		compiler.combinedJsonRequests == _other.compiler.combinedJsonRequests &&
 		metadata.format == _other.metadata.format &&
 		metadata.hash == _other.metadata.hash &&
@@ -256,6 +275,10 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		optimizer.optimizeYul == _other.optimizer.optimizeYul &&
 		optimizer.expectedExecutionsPerDeployment == _other.optimizer.expectedExecutionsPerDeployment &&
 		optimizer.yulSteps == _other.optimizer.yulSteps &&
+		optimizer.yulSearchBudget == _other.optimizer.yulSearchBudget &&
+		optimizer.stackLayoutSearchEffort == _other.optimizer.stackLayoutSearchEffort &&
+		optimizer.yulInlineBudget == _other.optimizer.yulInlineBudget &&
+		optimizer.yulStepProfile == _other.optimizer.yulStepProfile &&
 		modelChecker.initialize == _other.modelChecker.initialize &&
 		modelChecker.settings == _other.modelChecker.settings;
 }
@@ -290,6 +313,15 @@ OptimiserSettings CommandLineOptions::optimiserSettings() const
 			solAssert(settings.yulOptimiserCleanupSteps == OptimiserSettings::DefaultYulOptimiserCleanupSteps);
 	}
 
+	if (optimizer.yulSearchBudget.has_value())
+		settings.yulOptimiserSearchBudget = optimizer.yulSearchBudget.value();
+
+	if (optimizer.stackLayoutSearchEffort.has_value())
+		settings.stackLayoutSearchEffort = optimizer.stackLayoutSearchEffort.value();
+
+	if (optimizer.yulInlineBudget.has_value())
+		settings.yulOptimiserInlineBudget = optimizer.yulInlineBudget.value();
+
 	return settings;
 }
 
@@ -601,6 +633,13 @@ General Information)").c_str(),
 			g_strOverwrite.c_str(),
 			"Overwrite existing files (used together with -o)."
 		)
+		(
+			g_strCacheDir.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Directory in which the outputs of individual contracts are cached across invocations "
+			"in Standard JSON mode. Contracts whose sources, settings and requested outputs are "
+			"unchanged are not compiled again."
+		)
 		(
 			g_strEVMVersion.c_str(),
 			po::value<std::string>()->value_name("version")->default_value(EVMVersion{}.name()),
@@ -627,6 +666,13 @@ General Information)").c_str(),
 			g_strViaIR.c_str(),
 			"Turn on compilation mode via the IR."
 		)
+		(
+			g_strJobs.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Maximum number of threads used to parse sources, to run function-local Yul optimizer steps "
+			"on the functions of a contract and to generate EVM code from the IR for independent contracts. "
+			"The output does not depend on this setting."
+		)
 		(
 			g_strRevertStrings.c_str(),
 			po::value<std::string>()->value_name(util::joinHumanReadable(g_revertStringsArgs, ",")),
@@ -769,11 +815,24 @@ General Information)").c_str(),
 			g_strGas.c_str(),
 			"Print an estimate of the maximal gas usage for each function."
 		)
+		(
+			g_strGasEstimationEngine.c_str(),
+			po::value<std::string>()->value_name(util::joinHumanReadable(g_gasEstimationEngineArgs, ",")),
+			"Algorithm used by --gas and the gasEstimates output. \"path\" follows the paths through "
+			"the code one by one, \"dataflow\" analyses the control flow graph and is faster on large "
+			"contracts. Only \"dataflow\" bounds loops, namely those with a constant number of iterations."
+		)
 		(
 			g_strCombinedJson.c_str(),
 			po::value<std::string>()->value_name(util::joinHumanReadable(CombinedJsonRequests::componentMap() | ranges::views::keys, ",")),
 			"Output a single json document containing the specified information."
 		)
+		(
+			g_strTimeReport.c_str(),
+			"Report the wall time and peak memory usage of the compilation stages, per contract. "
+			"Printed to the standard output, or written as time_report.json in the Chrome trace "
+			"event format if --output-dir is given."
+		)
 	;
 	desc.add(extraOutput);
 
@@ -824,6 +883,31 @@ General Information)").c_str(),
 			po::value<std::string>()->value_name("steps"),
 			"Forces Yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strOptimizeSearch.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			("Let the Yul optimizer try n variations of its sequence of optimization steps for every object "
+			"and use the one that results in the cheapest code, taking --" + g_strOptimizeRuns + " into account. "
+			"The search is deterministic, but compilation takes considerably longer.").c_str()
+		)
+		(
+			g_strOptimizeStackLayoutSearch.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Let the code generator via IR spend up to n rounds of local search on improving the stack layouts "
+			"at conditional jumps of every function. Candidate layouts are compared by their stack shuffling costs."
+		)
+		(
+			g_strYulInlineBudget.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Limit the code size the Yul optimizer may add to every object by inlining functions that are called "
+			"more than once. Not limited by default."
+		)
+		(
+			g_strYulOptimizerProfile.c_str(),
+			"Output the duration and the code size before and after of every Yul optimizer step run, "
+			"along with the object and round it ran in, as JSON. Printed to the standard output, or "
+			"written as yul_optimizer_profile.json if --output-dir is given."
+		)
 	;
 	desc.add(optimizerOptions);
 
@@ -992,6 +1076,10 @@ void CommandLineParser::processArgs()
 		// TODO: This should eventually contain all options.
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strJobs, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::Assembler}},
+		{g_strTimeReport, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strYulOptimizerProfile, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::Assembler}},
+		{g_strCacheDir, {InputMode::StandardJson}},
 		{g_strMetadataLiteral, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strNoCBORMetadata, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataHash, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
@@ -1128,6 +1216,13 @@ void CommandLineParser::processArgs()
 	if (m_args.count(g_strOutputDir))
 		m_options.output.dir = m_args.at(g_strOutputDir).as<std::string>();
 
+	if (m_args.count(g_strCacheDir))
+	{
+		m_options.output.cacheDir = m_args.at(g_strCacheDir).as<std::string>();
+		if (m_options.output.cacheDir->empty())
+			solThrow(CommandLineValidationError, "--" + g_strCacheDir + " must not be empty.");
+	}
+
 	m_options.output.overwriteFiles = (m_args.count(g_strOverwrite) > 0);
 
 	if (m_args.count(g_strPrettyJson) > 0)
@@ -1143,6 +1238,18 @@ void CommandLineParser::processArgs()
 	parseOutputSelection();
 
 	m_options.compiler.estimateGas = (m_args.count(g_strGas) > 0);
+	if (m_args.count(g_strGasEstimationEngine))
+	{
+		std::string engineString = m_args[g_strGasEstimationEngine].as<std::string>();
+		std::optional<GasEstimationEngine> engine = gasEstimationEngineFromString(engineString);
+		if (!engine)
+			solThrow(
+				CommandLineValidationError,
+				"Invalid option for --" + g_strGasEstimationEngine + ": " + engineString
+			);
+		m_options.compiler.gasEstimationEngine = *engine;
+	}
+	m_options.compiler.timeReport = (m_args.count(g_strTimeReport) > 0);
 
 	if (m_args.count(g_strBasePath))
 		m_options.input.basePath = m_args[g_strBasePath].as<std::string>();
@@ -1254,12 +1361,45 @@ void CommandLineParser::processArgs()
 		m_options.optimizer.yulSteps = m_args[g_strYulOptimizations].as<std::string>();
 	}
 
+	if (m_args.count(g_strOptimizeSearch))
+	{
+		if (!m_options.optimiserSettings().runYulOptimiser)
+			solThrow(
+				CommandLineValidationError,
+				"--" + g_strOptimizeSearch + " requires the Yul optimizer to be enabled."
+			);
+		m_options.optimizer.yulSearchBudget = m_args[g_strOptimizeSearch].as<unsigned>();
+	}
+
+	if (m_args.count(g_strOptimizeStackLayoutSearch))
+	{
+		if (!m_options.optimiserSettings().runYulOptimiser)
+			solThrow(
+				CommandLineValidationError,
+				"--" + g_strOptimizeStackLayoutSearch + " requires the Yul optimizer to be enabled."
+			);
+		m_options.optimizer.stackLayoutSearchEffort = m_args[g_strOptimizeStackLayoutSearch].as<unsigned>();
+	}
+
+	if (m_args.count(g_strYulInlineBudget))
+	{
+		if (!m_options.optimiserSettings().runYulOptimiser)
+			solThrow(
+				CommandLineValidationError,
+				"--" + g_strYulInlineBudget + " requires the Yul optimizer to be enabled."
+			);
+		m_options.optimizer.yulInlineBudget = m_args[g_strYulInlineBudget].as<unsigned>();
+	}
+
+	m_options.optimizer.yulStepProfile = (m_args.count(g_strYulOptimizerProfile) > 0);
+
 	if (m_options.input.mode == InputMode::Assembler)
 	{
 		std::vector<std::string> const nonAssemblyModeOptions = {
 			// TODO: The list is not complete. Add more.
 			g_strOutputDir,
 			g_strGas,
+			g_strGasEstimationEngine,
 			g_strCombinedJson,
 		};
 		if (countEnabledOptions(nonAssemblyModeOptions) >= 1)
@@ -1434,6 +1574,14 @@ void CommandLineParser::processArgs()
 		m_args.count(g_strModelCheckerTimeout);
 	m_options.output.viaIR = (m_args.count(g_strExperimentalViaIR) > 0 || m_args.count(g_strViaIR) > 0);
 
+	if (!m_args[g_strJobs].defaulted())
+	{
+		unsigned jobs = m_args[g_strJobs].as<unsigned>();
+		if (jobs == 0)
+			solThrow(CommandLineValidationError, "--" + g_strJobs + " must be at least 1.");
+		m_options.output.parallelism = jobs;
+	}
+
 	solAssert(
 		m_options.input.mode == InputMode::Compiler ||
 		m_options.input.mode == InputMode::CompilerWithASTImport ||
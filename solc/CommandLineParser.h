@@ -23,6 +23,7 @@
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/DebugSettings.h>
 #include <libsolidity/interface/FileReader.h>
+#include <libsolidity/interface/GasEstimationSettings.h>
 #include <libsolidity/interface/ImportRemapper.h>
 
 #include <libyul/YulStack.h>
@@ -181,9 +182,11 @@ struct CommandLineOptions
 	struct
 	{
 		boost::filesystem::path dir;
+		std::optional<boost::filesystem::path> cacheDir;
 		bool overwriteFiles = false;
 		langutil::EVMVersion evmVersion;
 		bool viaIR = false;
+		size_t parallelism = 1;
 		RevertStrings revertStrings = RevertStrings::Default;
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
 		CompilerStack::State stopAfter = CompilerStack::State::CompilationSuccessful;
@@ -212,6 +215,8 @@ struct CommandLineOptions
 	{
 		CompilerOutputs outputs;
 		bool estimateGas = false;
+		GasEstimationEngine gasEstimationEngine = GasEstimationEngine::Path;
+		bool timeReport = false;
 		std::optional<CombinedJsonRequests> combinedJsonRequests;
 	} compiler;
 
@@ -228,6 +233,10 @@ struct CommandLineOptions
 		bool optimizeYul = false;
 		std::optional<unsigned> expectedExecutionsPerDeployment;
 		std::optional<std::string> yulSteps;
+		std::optional<unsigned> yulSearchBudget;
+		std::optional<unsigned> stackLayoutSearchEffort;
+		std::optional<unsigned> yulInlineBudget;
+		bool yulStepProfile = false;
 	} optimizer;
 
 	struct
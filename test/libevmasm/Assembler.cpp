@@ -420,6 +420,31 @@ BOOST_AUTO_TEST_CASE(subobject_encode_decode)
 	BOOST_CHECK(assembly.decodeSubPath(assembly.encodeSubPath(subPath)) == subPath);
 }
 
+BOOST_AUTO_TEST_CASE(assembly_item_data)
+{
+	u256 const large = (u256(1) << 200) + 7;
+	AssemblyItem small(u256(3));
+	AssemblyItem largeItem(large);
+	BOOST_CHECK_EQUAL(small.data(), 3);
+	BOOST_CHECK_EQUAL(largeItem.data(), large);
+	BOOST_CHECK(largeItem == AssemblyItem(large));
+	BOOST_CHECK(largeItem != AssemblyItem(large + 1));
+	BOOST_CHECK(small != largeItem);
+	BOOST_CHECK(small < largeItem);
+	BOOST_CHECK(!(largeItem < small));
+	BOOST_CHECK(largeItem < AssemblyItem(large + 1));
+	BOOST_CHECK(AssemblyItem(Instruction::ADD) == Instruction::ADD);
+	BOOST_CHECK(AssemblyItem(Instruction::ADD) < AssemblyItem(Instruction::MUL));
+
+	largeItem.setData(4);
+	BOOST_CHECK(largeItem == AssemblyItem(u256(4)));
+	small.setData(large);
+	BOOST_CHECK(small == AssemblyItem(large));
+
+	AssemblyItem foreignTag = AssemblyItem(Tag, 12).toSubAssemblyTag(3);
+	BOOST_CHECK(foreignTag.splitForeignPushTag() == std::make_pair(size_t(3), size_t(12)));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
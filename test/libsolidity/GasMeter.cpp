@@ -22,6 +22,7 @@
  */
 
 #include <test/libsolidity/SolidityExecutionFramework.h>
+#include <libevmasm/DataflowGasMeter.h>
 #include <libevmasm/GasMeter.h>
 #include <libevmasm/KnownState.h>
 #include <libevmasm/PathGasMeter.h>
@@ -53,18 +54,30 @@ public:
 	void testCreationTimeGas(std::string const& _sourceCode, u256 const& _tolerance = u256(0))
 	{
 		compileAndRun(_sourceCode);
+		AssemblyItems const& items = *m_compiler.assemblyItems(m_compiler.lastContractName());
 		auto state = std::make_shared<KnownState>();
-		PathGasMeter meter(*m_compiler.assemblyItems(m_compiler.lastContractName()), solidity::test::CommonOptions::get().evmVersion());
+		PathGasMeter meter(items, solidity::test::CommonOptions::get().evmVersion());
 		GasMeter::GasConsumption gas = meter.estimateMax(0, state);
 		u256 bytecodeSize(m_compiler.runtimeObject(m_compiler.lastContractName()).bytecode.size());
 		// costs for deployment
-		gas += bytecodeSize * GasCosts::createDataGas;
+		GasMeter::GasConsumption deploymentGas = bytecodeSize * GasCosts::createDataGas;
 		// costs for transaction
-		gas += gasForTransaction(m_compiler.object(m_compiler.lastContractName()).bytecode, true);
+		deploymentGas += gasForTransaction(m_compiler.object(m_compiler.lastContractName()).bytecode, true);
+		gas += deploymentGas;
 
 		BOOST_REQUIRE(!gas.isInfinite);
 		BOOST_CHECK_LE(m_gasUsed, gas.value);
 		BOOST_CHECK_LE(gas.value - _tolerance, m_gasUsed);
+
+		// The dataflow analysis loses knowledge where paths join, but still has to give an upper bound.
+		GasMeter::GasConsumption dataflowGas = deploymentGas + DataflowGasMeter::estimateMax(
+			items,
+			solidity::test::CommonOptions::get().evmVersion(),
+			0,
+			std::make_shared<KnownState>()
+		);
+		if (!dataflowGas.isInfinite)
+			BOOST_CHECK_LE(m_gasUsed, dataflowGas.value);
 	}
 
 	/// Compares the gas computed by PathGasMeter for the given signature (but unknown arguments)
@@ -82,6 +95,7 @@ public:
 			gas = std::max(gas, gasForTransaction(hash.asBytes() + arguments, false));
 		}
 
+		GasMeter::GasConsumption dataflowGas = gas;
 		gas += GasEstimator(solidity::test::CommonOptions::get().evmVersion()).functionalEstimation(
 			*m_compiler.runtimeAssemblyItems(m_compiler.lastContractName()),
 			_sig
@@ -89,6 +103,39 @@ public:
 		BOOST_REQUIRE(!gas.isInfinite);
 		BOOST_CHECK_LE(m_gasUsed, gas.value);
 		BOOST_CHECK_LE(gas.value - _tolerance, m_gasUsed);
+
+		dataflowGas += GasEstimator(
+			solidity::test::CommonOptions::get().evmVersion(),
+			GasEstimationEngine::Dataflow
+		).functionalEstimation(
+			*m_compiler.runtimeAssemblyItems(m_compiler.lastContractName()),
+			_sig
+		);
+		if (!dataflowGas.isInfinite)
+			BOOST_CHECK_LE(m_gasUsed, dataflowGas.value);
+	}
+
+	/// Checks that the dataflow engine finds a finite upper bound for the given signature
+	/// on the given set of argument variants.
+	void testRunTimeGasDataflow(std::string const& _sig, std::vector<bytes> _argumentVariants)
+	{
+		GasMeter::GasConsumption executionGas = GasEstimator(
+			solidity::test::CommonOptions::get().evmVersion(),
+			GasEstimationEngine::Dataflow
+		).functionalEstimation(
+			*m_compiler.runtimeAssemblyItems(m_compiler.lastContractName()),
+			_sig
+		);
+		BOOST_REQUIRE(!executionGas.isInfinite);
+
+		util::FixedHash<4> hash = util::selectorFromSignatureH32(_sig);
+		for (bytes const& arguments: _argumentVariants)
+		{
+			sendMessage(hash.asBytes() + arguments, false, 0);
+			BOOST_CHECK(m_transactionSuccessful);
+			GasMeter::GasConsumption gas = gasForTransaction(hash.asBytes() + arguments, false) + executionGas;
+			BOOST_CHECK_LE(m_gasUsed, gas.value);
+		}
 	}
 
 	static GasMeter::GasConsumption gasForTransaction(bytes const& _data, bool _isCreation)
@@ -230,6 +277,42 @@ BOOST_AUTO_TEST_CASE(multiple_external_functions)
 	testRunTimeGas("g(uint256)", std::vector<bytes>{encodeArgs(2)});
 }
 
+BOOST_AUTO_TEST_CASE(repeated_internal_calls)
+{
+	// The path based engine does not allow a path to enter the same function twice,
+	// the dataflow engine applies the summary of the function at each call.
+	char const* sourceCode = R"(
+		contract test {
+			uint data;
+			function f(uint x) public {
+				data = g(x) + g(x + 1);
+			}
+			function g(uint x) internal pure returns (uint) {
+				return x / 2;
+			}
+		}
+	)";
+	compileAndRun(sourceCode);
+	testRunTimeGasDataflow("f(uint256)", std::vector<bytes>{encodeArgs(2), encodeArgs(8)});
+}
+
+BOOST_AUTO_TEST_CASE(constant_loop)
+{
+	// Only the dataflow engine bounds loops, by executing them iteration by iteration. The
+	// counter stays known across the checked increment, which is a call of an internal function.
+	char const* sourceCode = R"(
+		contract test {
+			uint[10] data;
+			function f(uint x) public {
+				for (uint i = 0; i < 10; i++)
+					data[i] = x + i;
+			}
+		}
+	)";
+	compileAndRun(sourceCode);
+	testRunTimeGasDataflow("f(uint256)", std::vector<bytes>{encodeArgs(0), encodeArgs(7)});
+}
+
 BOOST_AUTO_TEST_CASE(exponent_size)
 {
 	char const* sourceCode = R"(
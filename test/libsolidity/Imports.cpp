@@ -25,6 +25,7 @@
 #include <test/Common.h>
 
 #include <liblangutil/Exceptions.h>
+#include <libsolidity/ast/ASTJsonExporter.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/ImportRemapper.h>
 
@@ -112,6 +113,87 @@ BOOST_AUTO_TEST_CASE(context_dependent_remappings_order_independent_2)
 	BOOST_CHECK(c.compile());
 }
 
+BOOST_AUTO_TEST_CASE(parallel_parsing)
+{
+	// Only a.sol and e.sol are given, the others are loaded in two further waves.
+	std::map<std::string, std::string> files{
+		{"b.sol", "import \"d.sol\"; contract B is D { function f() public { assembly { mstore(0, 1) } } } pragma solidity >=0.0;"},
+		{"c.sol", "import \"d.sol\"; contract C is D {} pragma solidity >=0.0;"},
+		{"d.sol", "contract D {} pragma solidity >=0.0;"}
+	};
+	ReadCallback::Callback reader = [&](std::string const&, std::string const& _path) {
+		if (files.count(_path))
+			return ReadCallback::Result{true, files.at(_path)};
+		return ReadCallback::Result{false, "File not found."};
+	};
+
+	for (char const* e: {"contract E { function g() public {} } pragma solidity >=0.0;", "contract E {"})
+	{
+		std::vector<std::map<std::string, Json>> asts;
+		std::vector<std::vector<std::string>> errors;
+		for (size_t parallelism: std::vector<size_t>{1, 4})
+		{
+			CompilerStack c(reader);
+			c.setParallelism(parallelism);
+			c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+			c.setSources({
+				{"a.sol", "import \"b.sol\"; import \"c.sol\"; contract A is B, C {} pragma solidity >=0.0;"},
+				{"e.sol", e}
+			});
+			bool const success = c.parseAndAnalyze();
+
+			asts.emplace_back();
+			if (success)
+				for (std::string const& name: c.sourceNames())
+					asts.back()[name] = ASTJsonExporter(c.state()).toJson(c.ast(name));
+			errors.emplace_back();
+			for (auto const& error: c.errors())
+				errors.back().push_back(error->what());
+		}
+		BOOST_CHECK(asts[0] == asts[1]);
+		BOOST_CHECK(errors[0] == errors[1]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallel_parsing_error_limit)
+{
+	// Each source has 100 errors, so the limit of 256 errors is exceeded in the third one.
+	std::string emptyEnums;
+	for (size_t i = 0; i < 100; ++i)
+		emptyEnums += "enum E" + std::to_string(i) + " {} ";
+
+	std::vector<std::vector<std::string>> errors;
+	for (size_t parallelism: std::vector<size_t>{1, 4})
+	{
+		CompilerStack c;
+		c.setParallelism(parallelism);
+		c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		c.setSources({
+			{"a.sol", emptyEnums},
+			{"b.sol", emptyEnums},
+			{"c.sol", emptyEnums},
+			{"d.sol", emptyEnums}
+		});
+		BOOST_CHECK(!c.parse());
+
+		errors.emplace_back();
+		size_t errorCount = 0;
+		size_t abortCount = 0;
+		for (auto const& error: c.errors())
+		{
+			errors.back().push_back(error->what());
+			if (langutil::Error::isError(error->type()))
+				++errorCount;
+			else if (error->errorId() == langutil::ErrorId{4013})
+				++abortCount;
+		}
+		BOOST_CHECK_EQUAL(errorCount, 256);
+		// One for the third source and one for the fourth.
+		BOOST_CHECK_EQUAL(abortCount, 2);
+	}
+	BOOST_CHECK(errors[0] == errors[1]);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -23,11 +23,13 @@
 #include <string>
 #include <boost/test/unit_test.hpp>
 #include <boost/algorithm/string/replace.hpp>
+#include <boost/algorithm/string/predicate.hpp>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/TemporaryDirectory.h>
 #include <test/Metadata.h>
 
 #include <algorithm>
@@ -142,9 +144,11 @@ void expectLinkReferences(Json const& _contractResult, std::map<std::string, std
 	}
 }
 
-Json compile(std::string _input)
+Json compile(std::string _input, std::optional<boost::filesystem::path> const& _cacheDirectory = std::nullopt)
 {
 	StandardCompiler compiler;
+	if (_cacheDirectory.has_value())
+		compiler.setCacheDirectory(*_cacheDirectory);
 	std::string output = compiler.compile(std::move(_input));
 	Json ret;
 	BOOST_REQUIRE(util::jsonParseStrict(output, ret));
@@ -1783,6 +1787,271 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 	BOOST_REQUIRE(sourceMap.find(sourceRef) != std::string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(parallelism_invalid)
+{
+	for (std::string const& value: {"0", "-1", "\"2\"", "true"})
+	{
+		std::string input = R"(
+		{
+			"language": "Solidity",
+			"sources":
+			{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+			"settings": { "parallelism": )" + value + R"( }
+		}
+		)";
+		Json result = compile(input);
+		BOOST_CHECK(containsError(result, "JSONError", "\"settings.parallelism\" must be a positive integer."));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_does_not_affect_output)
+{
+	std::string const sources = R"(
+		"A.sol": {
+			"content": "contract A { uint public x; function f(uint y) public { x = y * 2; } }"
+		},
+		"B.sol": {
+			"content": "import \"A.sol\"; contract B { A a = new A(); function g() public { a.f(7); } }"
+		},
+		"C.sol": {
+			"content": "import \"B.sol\"; contract C { B b; function h() public returns (B) { b = new B(); return b; } } contract D { function k() public pure returns (bytes memory) { return type(A).creationCode; } }"
+		}
+	)";
+	auto compileWithParallelism = [&](size_t _parallelism) {
+		std::string input = R"(
+		{
+			"language": "Solidity",
+			"sources": {)" + sources + R"(},
+			"settings": {
+				"viaIR": true,
+				"optimizer": { "enabled": true },
+				"parallelism": )" + std::to_string(_parallelism) + R"(,
+				"outputSelection": { "*": { "*": ["evm.bytecode", "evm.deployedBytecode", "evm.assembly", "irOptimized"] } }
+			}
+		}
+		)";
+		Json result = compile(input);
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		return result;
+	};
+
+	Json sequential = compileWithParallelism(1);
+	BOOST_REQUIRE(sequential["contracts"].size() == 3);
+	for (size_t parallelism: std::vector<size_t>{2, 4})
+		BOOST_CHECK(compileWithParallelism(parallelism) == sequential);
+}
+
+BOOST_AUTO_TEST_CASE(time_report)
+{
+	auto compileWithTimeReport = [&](std::string const& _timeReport) {
+		std::string input = R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": { "content": "contract A { function f() public pure {} } contract B { A a = new A(); }" }
+			},
+			"settings": {
+				"viaIR": true,
+				"debug": { "timeReport": )" + _timeReport + R"( },
+				"outputSelection": { "*": { "*": ["evm.bytecode"] } }
+			}
+		}
+		)";
+		return compile(input);
+	};
+
+	BOOST_CHECK(containsError(compileWithTimeReport("\"yes\""), "JSONError", "settings.debug.timeReport must be a Boolean."));
+	BOOST_CHECK(!compileWithTimeReport("false").contains("timeReport"));
+
+	Json result = compileWithTimeReport("true");
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_REQUIRE(result["timeReport"]["traceEvents"].is_array());
+	std::set<std::string> stages;
+	std::set<std::string> contracts;
+	for (Json const& event: result["timeReport"]["traceEvents"])
+	{
+		BOOST_CHECK(event["ph"] == "X");
+		stages.insert(event["name"].get<std::string>());
+		if (event["args"].contains("contract"))
+			contracts.insert(event["args"]["contract"].get<std::string>());
+	}
+	for (std::string const& stage: {"Parsing", "Analysis", "Type checking", "Yul IR", "Yul optimization", "EVM code generation"})
+		BOOST_CHECK_MESSAGE(stages.count(stage), "Missing stage: " + stage);
+	BOOST_CHECK(contracts == (std::set<std::string>{"A.sol:A", "A.sol:B"}));
+}
+
+BOOST_AUTO_TEST_CASE(yul_optimizer_profile)
+{
+	std::string const steps = R"("optimizer": { "enabled": true, "details": { "yulDetails": { "optimizerSteps": "xa[cu]s:fDnTOcmu" } } })";
+	auto checkProfile = [](Json const& _profile, std::string const& _object) {
+		BOOST_REQUIRE(_profile["steps"].is_array());
+		size_t repeatedRuns = 0;
+		for (Json const& step: _profile["steps"])
+		{
+			BOOST_CHECK(step["object"] == _object);
+			BOOST_CHECK(step["durationMicroseconds"].is_number_integer());
+			BOOST_CHECK(step["codeSizeBefore"].is_number_unsigned());
+			BOOST_CHECK(step["codeSizeAfter"].is_number_unsigned());
+			if (step["step"] == "ExpressionSplitter")
+				BOOST_CHECK(step["round"] == 0);
+			if (step["step"] == "UnusedPruner" && step["round"] != 0)
+				repeatedRuns++;
+		}
+		// The repeated subsequence runs at least once and at most until it is stable.
+		BOOST_CHECK(repeatedRuns >= 1);
+		BOOST_CHECK(_profile["summary"]["ExpressionSplitter"]["runs"] == 1);
+	};
+
+	std::string const solidityInput = R"(
+	{
+		"language": "Solidity",
+		"sources": { "A.sol": { "content": "contract C { function f(uint x) public pure returns (uint) { return x * 2 + x * 2; } }" } },
+		"settings": {
+			"viaIR": true,
+			)" + steps + R"(,
+			"debug": { "yulOptimizerProfile": true },
+			"outputSelection": { "*": { "*": ["evm.bytecode"] } }
+		}
+	}
+	)";
+	Json result = compile(solidityInput);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_REQUIRE(result["yulOptimizerProfile"]["A.sol"]["C"].is_object());
+	Json const& solidityProfile = result["yulOptimizerProfile"]["A.sol"]["C"];
+	std::set<std::string> objects;
+	for (Json const& step: solidityProfile["steps"])
+		objects.insert(step["object"].get<std::string>());
+	// Creation and deployed object.
+	BOOST_REQUIRE_EQUAL(objects.size(), 2u);
+	BOOST_CHECK(boost::ends_with(*objects.rbegin(), "_deployed"));
+	BOOST_CHECK(solidityProfile["summary"]["ExpressionSplitter"]["runs"] == 2);
+
+	// The cache is bypassed, so that the profile is complete on repeated compilations.
+	util::TemporaryDirectory cacheDirectory("solidity-cache");
+	for (size_t i = 0; i < 2; ++i)
+	{
+		Json cachedResult = compile(solidityInput, cacheDirectory.path());
+		BOOST_REQUIRE(containsAtMostWarnings(cachedResult));
+		BOOST_CHECK_EQUAL(
+			cachedResult["yulOptimizerProfile"]["A.sol"]["C"]["steps"].size(),
+			solidityProfile["steps"].size()
+		);
+	}
+	BOOST_CHECK(boost::filesystem::is_empty(cacheDirectory.path()));
+
+	std::string const yulInput = R"(
+	{
+		"language": "Yul",
+		"sources": { "A.yul": { "content": "object \"a\" { code { let x := calldataload(0) sstore(0, add(mul(x, 2), mul(x, 2))) } }" } },
+		"settings": {
+			)" + steps + R"(,
+			"debug": { "yulOptimizerProfile": true },
+			"outputSelection": { "*": { "*": ["evm.bytecode"] } }
+		}
+	}
+	)";
+	result = compile(yulInput);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	checkProfile(result["yulOptimizerProfile"]["A.yul"]["a"], "a");
+
+	BOOST_CHECK(!compile(boost::replace_all_copy(yulInput, "\"yulOptimizerProfile\": true", "\"yulOptimizerProfile\": false")).contains("yulOptimizerProfile"));
+}
+
+BOOST_AUTO_TEST_CASE(cache_does_not_affect_output)
+{
+	util::TemporaryDirectory cacheDirectory("solidity-cache");
+	auto cacheEntries = [&]() {
+		auto entries = boost::filesystem::directory_iterator(cacheDirectory.path());
+		return static_cast<size_t>(std::distance(entries, boost::filesystem::directory_iterator{}));
+	};
+	auto makeInput = [](std::string const& _factor, std::string const& _settings) {
+		return R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": {
+					"content": "contract A { uint public x; function f(uint y) public { x = y * )" + _factor + R"(; } }"
+				},
+				"B.sol": {
+					"content": "import \"A.sol\"; contract B { A a = new A(); function g() public { a.f(7); } }"
+				}
+			},
+			"settings": {
+				)" + _settings + R"(
+				"outputSelection": { "*": { "*": ["abi", "metadata", "evm.bytecode", "evm.deployedBytecode", "evm.assembly", "evm.gasEstimates"] } }
+			}
+		}
+		)";
+	};
+
+	std::string const input = makeInput("2", "");
+	Json const uncached = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(uncached));
+
+	BOOST_CHECK(compile(makeInput("2", R"("cache": false,)"), cacheDirectory.path()) == uncached);
+	BOOST_CHECK_EQUAL(cacheEntries(), 0);
+
+	BOOST_CHECK(compile(input, cacheDirectory.path()) == uncached);
+	BOOST_CHECK_EQUAL(cacheEntries(), 2);
+	// Served from the cache.
+	BOOST_CHECK(compile(input, cacheDirectory.path()) == uncached);
+	BOOST_CHECK_EQUAL(cacheEntries(), 2);
+
+	// Changing a source invalidates the contracts depending on it.
+	std::string const changedSource = makeInput("3", "");
+	BOOST_CHECK(compile(changedSource, cacheDirectory.path()) == compile(changedSource));
+	BOOST_CHECK_EQUAL(cacheEntries(), 4);
+
+	// So does changing the settings.
+	std::string const changedSettings = makeInput("2", R"("optimizer": { "enabled": true, "runs": 1000 },)");
+	BOOST_CHECK(compile(changedSettings, cacheDirectory.path()) == compile(changedSettings));
+	BOOST_CHECK_EQUAL(cacheEntries(), 6);
+}
+
+BOOST_AUTO_TEST_CASE(cache_all_outputs_cached)
+{
+	util::TemporaryDirectory cacheDirectory("solidity-cache");
+	// Only A is requested, so with A cached, code generation does not run at all and B
+	// must not have any output that depends on it.
+	std::string const input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": { "content": "contract A { function f() public pure returns (uint) { return 1; } }" },
+			"B.sol": { "content": "contract B { function g() public pure returns (uint) { return 2; } }" }
+		},
+		"settings": {
+			"viaIR": true,
+			"outputSelection": {
+				"A.sol": { "A": ["*"] },
+				"B.sol": { "": ["ast"] }
+			}
+		}
+	}
+	)";
+	Json const uncached = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(uncached));
+	BOOST_REQUIRE(uncached["contracts"]["A.sol"]["A"].contains("irOptimized"));
+	BOOST_REQUIRE(!uncached["contracts"].contains("B.sol"));
+
+	BOOST_CHECK(compile(input, cacheDirectory.path()) == uncached);
+	Json const cached = compile(input, cacheDirectory.path());
+	BOOST_CHECK(containsAtMostWarnings(cached));
+	BOOST_CHECK(cached == uncached);
+}
+
+BOOST_AUTO_TEST_CASE(cache_invalid)
+{
+	std::string const input = R"(
+	{
+		"language": "Solidity",
+		"sources": { "A.sol": { "content": "contract A {}" } },
+		"settings": { "cache": 1 }
+	}
+	)";
+	BOOST_CHECK(containsError(compile(input), "JSONError", "\"settings.cache\" must be a Boolean."));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
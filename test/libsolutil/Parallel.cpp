@@ -0,0 +1,95 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ParallelTests, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(runs_every_task_once)
+{
+	for (size_t concurrency: std::vector<size_t>{0, 1, 2, 8})
+	{
+		std::vector<std::atomic<unsigned>> calls(100);
+		parallelFor(calls.size(), concurrency, [&](size_t _index) { ++calls[_index]; });
+		for (auto const& count: calls)
+			BOOST_CHECK_EQUAL(count.load(), 1u);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(no_tasks)
+{
+	bool called = false;
+	parallelFor(0, 4, [&](size_t) { called = true; });
+	BOOST_CHECK(!called);
+}
+
+BOOST_AUTO_TEST_CASE(sequential_order)
+{
+	std::vector<size_t> order;
+	parallelFor(5, 1, [&](size_t _index) { order.push_back(_index); });
+	BOOST_CHECK(order == (std::vector<size_t>{0, 1, 2, 3, 4}));
+}
+
+BOOST_AUTO_TEST_CASE(rethrows_exception_of_smallest_index)
+{
+	for (size_t concurrency: std::vector<size_t>{1, 4})
+	{
+		std::string message;
+		try
+		{
+			parallelFor(64, concurrency, [&](size_t _index) {
+				if (_index == 3 || _index == 17)
+					throw std::runtime_error(std::to_string(_index));
+			});
+		}
+		catch (std::runtime_error const& _exception)
+		{
+			message = _exception.what();
+		}
+		BOOST_CHECK_EQUAL(message, "3");
+	}
+}
+
+BOOST_AUTO_TEST_CASE(nested_calls)
+{
+	std::vector<std::atomic<unsigned>> calls(8 * 32);
+	parallelFor(8, 4, [&](size_t _outer) {
+		parallelFor(32, 4, [&](size_t _inner) { ++calls[_outer * 32 + _inner]; });
+	});
+	for (auto const& count: calls)
+		BOOST_CHECK_EQUAL(count.load(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(hardware_concurrency)
+{
+	BOOST_CHECK(hardwareConcurrency() >= 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
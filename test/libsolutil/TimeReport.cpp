@@ -0,0 +1,102 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/TimeReport.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(TimeReportTests, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(no_report)
+{
+	TimeReport::Stage stage(nullptr, "Parsing");
+	TimeReport::Stage nested("Analysis");
+}
+
+BOOST_AUTO_TEST_CASE(nested_stages)
+{
+	TimeReport report;
+	{
+		TimeReport::Stage outer(&report, "Code generation", "a.sol:C");
+		TimeReport::Stage inner("Yul optimization", "C_1");
+		{
+			TimeReport::Stage innermost("evmasm optimization");
+		}
+	}
+	{
+		TimeReport::Stage parsing(&report, "Parsing");
+	}
+	// Not nested in any stage.
+	TimeReport::Stage orphan("Orphan");
+
+	std::vector<TimeReport::Event> events = report.events();
+	BOOST_REQUIRE_EQUAL(events.size(), 4u);
+
+	BOOST_CHECK_EQUAL(events[0].name, "Code generation");
+	BOOST_CHECK_EQUAL(events[0].contract, "a.sol:C");
+	BOOST_CHECK_EQUAL(events[0].depth, 0u);
+	BOOST_CHECK_EQUAL(events[1].name, "Yul optimization");
+	BOOST_CHECK_EQUAL(events[1].contract, "a.sol:C");
+	BOOST_CHECK_EQUAL(events[1].object, "C_1");
+	BOOST_CHECK_EQUAL(events[1].depth, 1u);
+	BOOST_CHECK_EQUAL(events[2].name, "evmasm optimization");
+	BOOST_CHECK_EQUAL(events[2].depth, 2u);
+	BOOST_CHECK_EQUAL(events[3].name, "Parsing");
+	BOOST_CHECK_EQUAL(events[3].contract, "");
+	BOOST_CHECK_EQUAL(events[3].depth, 0u);
+
+	BOOST_CHECK(events[0].duration >= events[1].duration);
+	BOOST_CHECK(events[1].duration >= events[2].duration);
+
+	std::string formatted = report.format();
+	BOOST_CHECK(formatted.find("a.sol:C:\n  Code generation: ") != std::string::npos);
+	BOOST_CHECK(formatted.find("\n    Yul optimization (C_1): ") != std::string::npos);
+	BOOST_CHECK(formatted.find("All sources:\n  Parsing: ") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(chrome_trace)
+{
+	TimeReport report;
+	{
+		TimeReport::Stage stage(&report, "Code generation", "a.sol:C");
+	}
+	std::thread([&]() { TimeReport::Stage stage(&report, "EVM code generation", "a.sol:D"); }).join();
+
+	Json trace = report.chromeTrace();
+	BOOST_REQUIRE(trace["traceEvents"].is_array());
+	BOOST_REQUIRE_EQUAL(trace["traceEvents"].size(), 2u);
+
+	Json const& first = trace["traceEvents"][0];
+	BOOST_CHECK_EQUAL(first["name"], "Code generation");
+	BOOST_CHECK_EQUAL(first["cat"], "a.sol:C");
+	BOOST_CHECK_EQUAL(first["ph"], "X");
+	BOOST_CHECK_EQUAL(first["tid"], 0);
+	BOOST_CHECK_EQUAL(first["args"]["contract"], "a.sol:C");
+	BOOST_CHECK_EQUAL(trace["traceEvents"][1]["tid"], 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -25,9 +25,14 @@
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/InlinableExpressionFunctionFinder.h>
 #include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/FunctionCallFinder.h>
 #include <libyul/optimiser/FunctionHoister.h>
 #include <libyul/optimiser/FunctionGrouper.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/AST.h>
+#include <libyul/Object.h>
 
 #include <boost/test/unit_test.hpp>
 
@@ -53,6 +58,50 @@ std::string inlinableFunctions(std::string const& _source)
 	return boost::algorithm::join(functionNames, ",");
 }
 
+/// Runs the full inliner on @a _source with the budget @a _inlineBudget, which is reduced by
+/// the code size the run adds, and @returns the resulting code.
+std::shared_ptr<Object> runFullInliner(std::string const& _source, std::optional<size_t>& _inlineBudget)
+{
+	EVMDialect dialect{langutil::EVMVersion{}, true};
+	langutil::ErrorList errors;
+	std::shared_ptr<Object> object = parse(_source, dialect, errors).first;
+	BOOST_REQUIRE(object && errors.empty() && object->code);
+	Block& ast = *object->code;
+
+	NameDispenser dispenser{dialect, ast};
+	std::set<YulString> reserved;
+	OptimiserStepContext context{dialect, dispenser, reserved, 200};
+	context.inlineBudget = _inlineBudget;
+	FullInliner::run(context, ast);
+	_inlineBudget = context.inlineBudget;
+	return object;
+}
+
+/// Runs the full inliner with the given budget and @returns the number of calls to
+/// ``f`` and ``g`` left in the global block.
+std::pair<size_t, size_t> remainingCallsAfterFullInliner(std::optional<size_t> _inlineBudget)
+{
+	std::string const source = R"(
+		{
+			{
+				let x := calldataload(0)
+				let a := f(x)
+				let b := f(a)
+				let c := g(b)
+				sstore(c, 1)
+			}
+			function f(p) -> r { r := sload(mul(p, add(p, 3))) }
+			function g(q) -> s { s := sload(add(q, 1)) }
+		}
+	)";
+	std::shared_ptr<Object> object = runFullInliner(source, _inlineBudget);
+	Block& globalBlock = std::get<Block>(object->code->statements.front());
+	return {
+		findFunctionCalls(globalBlock, "f"_yulstring).size(),
+		findFunctionCalls(globalBlock, "g"_yulstring).size()
+	};
+}
+
 }
 
 
@@ -106,4 +155,125 @@ BOOST_AUTO_TEST_CASE(negative)
 }
 
 
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(YulFullInlinerBudget)
+
+BOOST_AUTO_TEST_CASE(unlimited_by_default)
+{
+	BOOST_CHECK(remainingCallsAfterFullInliner(std::nullopt) == std::make_pair(size_t(0), size_t(0)));
+}
+
+BOOST_AUTO_TEST_CASE(budget_for_one_copy)
+{
+	// The function ``f`` has size 4 and is called twice, so only one call fits the budget.
+	// The single call to ``g`` does not grow the code and is always inlined.
+	BOOST_CHECK(remainingCallsAfterFullInliner(4) == std::make_pair(size_t(1), size_t(0)));
+}
+
+BOOST_AUTO_TEST_CASE(no_budget)
+{
+	BOOST_CHECK(remainingCallsAfterFullInliner(0) == std::make_pair(size_t(2), size_t(0)));
+}
+
+BOOST_AUTO_TEST_CASE(budget_is_reduced_by_every_run)
+{
+	std::string const source = R"(
+		{
+			{
+				let x := calldataload(0)
+				let y := add(x, 1)
+				sstore(f(x), f(y))
+			}
+			function f(p) -> r { r := sload(mul(p, add(p, 3))) }
+		}
+	)";
+	// The calls are arguments of ``sstore`` and thus not inlined, so the budget is not reduced.
+	std::optional<size_t> budget = 10;
+	runFullInliner(source, budget);
+	BOOST_CHECK(budget == size_t(10));
+
+	std::string const splitSource = R"(
+		{
+			{
+				let x := calldataload(0)
+				let y := add(x, 1)
+				let a := f(x)
+				let b := f(y)
+				sstore(a, b)
+			}
+			function f(p) -> r { r := sload(mul(p, add(p, 3))) }
+		}
+	)";
+	// Every copy of ``f`` is estimated to add its size of 4, but actually adds 3, since the call
+	// it replaces is removed.
+	runFullInliner(splitSource, budget);
+	BOOST_CHECK(budget == size_t(4));
+	// The remaining budget suffices for one more copy of ``f``.
+	std::shared_ptr<Object> object = runFullInliner(splitSource, budget);
+	BOOST_CHECK(budget == size_t(1));
+	BOOST_CHECK_EQUAL(findFunctionCalls(std::get<Block>(object->code->statements.front()), "f"_yulstring).size(), 1);
+	// Not for another one.
+	object = runFullInliner(splitSource, budget);
+	BOOST_CHECK(budget == size_t(1));
+	BOOST_CHECK_EQUAL(findFunctionCalls(std::get<Block>(object->code->statements.front()), "f"_yulstring).size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(growth_during_the_pass)
+{
+	std::string const source = R"(
+		{
+			{
+				let a := g(7)
+				let b := g(8)
+				sstore(a, b)
+			}
+			function f(p) -> r { r := sload(mul(p, add(p, 3))) }
+			function g(q) -> s {
+				let t := f(q)
+				let u := f(t)
+				s := add(t, u)
+			}
+		}
+	)";
+	// Before the pass, the four calls are planned to add 4 + 4 + 3 + 3 = 14. Inlining ``f``
+	// into ``g`` grows ``g`` to 9, so the copies of ``g`` do not fit into the budget any more.
+	std::optional<size_t> budget = 14;
+	std::shared_ptr<Object> object = runFullInliner(source, budget);
+	Block const& globalBlock = std::get<Block>(object->code->statements.front());
+	BOOST_CHECK_EQUAL(findFunctionCalls(globalBlock, "g"_yulstring).size(), 2);
+	// ``g`` grew by 6 and ``f`` with a size of 5 including its definition is not called any more.
+	BOOST_CHECK(budget == size_t(13));
+}
+
+BOOST_AUTO_TEST_CASE(calls_in_loops_first)
+{
+	std::string const source = R"(
+		{
+			{
+				let x := calldataload(0)
+				let a := f(x)
+				for { } lt(a, 10) { a := add(a, 1) }
+				{
+					let b := f(a)
+					sstore(b, 1)
+				}
+			}
+			function f(p) -> r { r := sload(mul(p, add(p, 3))) }
+		}
+	)";
+	// Only one copy of ``f`` fits the budget. It is used for the call in the loop.
+	std::optional<size_t> budget = 4;
+	std::shared_ptr<Object> object = runFullInliner(source, budget);
+	BOOST_CHECK(budget == size_t(1));
+	Block const& globalBlock = std::get<Block>(object->code->statements.front());
+	BOOST_CHECK_EQUAL(findFunctionCalls(globalBlock, "f"_yulstring).size(), 1);
+	ForLoop const* loop = nullptr;
+	for (auto const& statement: globalBlock.statements)
+		if (auto const* forLoop = std::get_if<ForLoop>(&statement))
+			loop = forLoop;
+	BOOST_REQUIRE(loop);
+	BOOST_CHECK(findFunctionCalls(loop->body, "f"_yulstring).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
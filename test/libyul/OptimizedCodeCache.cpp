@@ -0,0 +1,188 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for reusing optimized code of identical Yul objects.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+#include <libyul/OptimizedCodeCache.h>
+#include <libyul/YulStack.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+std::string const source = R"(
+	/// @use-src 0:"a.sol"
+	object "A" {
+		code {
+			/// @src 0:0:10
+			datacopy(0, dataoffset("B"), datasize("B"))
+			datacopy(0, dataoffset("C"), datasize("C"))
+			return(0, add(datasize("B"), datasize("C")))
+		}
+		object "B" {
+			code {
+				/// @src 0:20:30
+				let x := calldataload(0)
+				sstore(add(x, 1), mul(x, 2))
+			}
+		}
+		object "C" {
+			code {
+				/// @src 0:20:30
+				let x := calldataload(0)
+				sstore(add(x, 1), mul(x, 2))
+			}
+		}
+	}
+)";
+
+std::string const sourceWithSharedFunction = R"(
+	/// @use-src 0:"a.sol"
+	object "A" {
+		code {
+			/// @src 0:0:10
+			function f(x) -> y { y := add(mul(x, 1), 0) }
+			sstore(0, f(calldataload(0)))
+		}
+		object "B" {
+			code {
+				/// @src 0:0:10
+				function f(x) -> y { y := add(mul(x, 1), 0) }
+				sstore(1, f(calldataload(1)))
+			}
+		}
+	}
+)";
+
+std::string optimize(
+	std::shared_ptr<OptimizedCodeCache> _cache,
+	std::string const& _source = source,
+	frontend::OptimiserSettings _settings = frontend::OptimiserSettings::full(),
+	size_t _concurrency = 1
+)
+{
+	YulStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion(),
+		YulStack::Language::StrictAssembly,
+		std::move(_settings),
+		langutil::DebugInfoSelection::All()
+	);
+	stack.setOptimizedCodeCache(std::move(_cache));
+	stack.setConcurrency(_concurrency);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", _source));
+	stack.optimize();
+	return stack.print();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulOptimizedCodeCache)
+
+BOOST_AUTO_TEST_CASE(identical_objects_are_optimized_once)
+{
+	auto cache = std::make_shared<OptimizedCodeCache>();
+	std::string withCache = optimize(cache);
+	// "B" and "C" share one entry.
+	BOOST_CHECK_EQUAL(cache->size(), 2u);
+	BOOST_CHECK_EQUAL(withCache, optimize(nullptr));
+
+	// A second stack with the same settings can reuse all of it.
+	BOOST_CHECK_EQUAL(optimize(cache), withCache);
+	BOOST_CHECK_EQUAL(cache->size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(identical_functions_are_simplified_once)
+{
+	frontend::OptimiserSettings settings = frontend::OptimiserSettings::full();
+	settings.yulOptimiserSteps = "s";
+	settings.yulOptimiserCleanupSteps = "";
+
+	auto cache = std::make_shared<OptimizedCodeCache>();
+	std::string withCache = optimize(cache, sourceWithSharedFunction, settings, 2);
+	// One entry for each of "A" and "B" and one for the result of the ExpressionSimplifier on "f".
+	BOOST_CHECK_EQUAL(cache->size(), 3u);
+	BOOST_CHECK_EQUAL(withCache, optimize(nullptr, sourceWithSharedFunction, settings, 2));
+	BOOST_CHECK_EQUAL(withCache, optimize(nullptr, sourceWithSharedFunction, settings));
+	BOOST_CHECK(withCache.find("mul(") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(functions_are_not_memoized_on_a_single_thread)
+{
+	frontend::OptimiserSettings settings = frontend::OptimiserSettings::full();
+	settings.yulOptimiserSteps = "s";
+	settings.yulOptimiserCleanupSteps = "";
+
+	auto cache = std::make_shared<OptimizedCodeCache>();
+	optimize(cache, sourceWithSharedFunction, settings);
+	// Only the entries for "A" and "B".
+	BOOST_CHECK_EQUAL(cache->size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(reused_functions_keep_their_locations_in_the_yul_code)
+{
+	frontend::OptimiserSettings settings = frontend::OptimiserSettings::full();
+	settings.yulOptimiserSteps = "s";
+	settings.yulOptimiserCleanupSteps = "";
+
+	YulStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion(),
+		YulStack::Language::StrictAssembly,
+		settings,
+		langutil::DebugInfoSelection::All()
+	);
+	auto cache = std::make_shared<OptimizedCodeCache>();
+	stack.setOptimizedCodeCache(cache);
+	stack.setConcurrency(2);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", sourceWithSharedFunction));
+	stack.optimize();
+	BOOST_CHECK_EQUAL(cache->size(), 3u);
+
+	auto bodyLocation = [](Object const& _object) {
+		for (Statement const& statement: _object.code->statements)
+			if (auto const* function = std::get_if<FunctionDefinition>(&statement))
+				return nativeLocationOf(function->body.statements.front());
+		BOOST_FAIL("Function not found.");
+		return langutil::SourceLocation{};
+	};
+	std::shared_ptr<Object> object = stack.parserResult();
+	BOOST_REQUIRE_EQUAL(object->subObjects.size(), 1u);
+	auto const* subObject = dynamic_cast<Object const*>(object->subObjects.front().get());
+	BOOST_REQUIRE(subObject);
+
+	// Both functions are located in their own object, whichever of them the result was memoized for.
+	int const subObjectStart = static_cast<int>(sourceWithSharedFunction.find("object \"B\""));
+	BOOST_CHECK(bodyLocation(*object).end < subObjectStart);
+	BOOST_CHECK(bodyLocation(*subObject).start > subObjectStart);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,284 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for running function-local optimiser steps on several threads.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/optimiser/Suite.h>
+#include <libyul/YulStack.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+std::vector<std::string> const sources{
+	R"(
+		{
+			let x := calldataload(0)
+			sstore(f(x), g(x, 1))
+			sstore(h(x), g(add(x, 2), mload(x)))
+			function f(a) -> r {
+				for { let i := 0 } lt(i, a) { i := add(i, 1) } {
+					r := add(r, mul(sload(i), 2))
+					if gt(r, 100) { break }
+				}
+				if gt(a, 10) { r := add(r, f(sub(a, 1))) }
+			}
+			function g(a, b) -> r {
+				let y := add(a, b)
+				let z := add(a, b)
+				mstore(y, z)
+				r := keccak256(y, 32)
+				switch calldataload(r)
+				case 0 { r := add(r, 1) }
+				default { revert(0, 0) }
+			}
+			function h(a) -> r {
+				r := sload(a)
+				sstore(a, r)
+				if iszero(a) { r := f(sub(a, 1)) }
+			}
+		}
+	)",
+	// Side-effects of functions that terminate or call each other are needed in other functions.
+	R"(
+		{
+			mstore(0x40, 0x80)
+			let p := alloc(calldataload(0))
+			store(p, calldataload(32))
+			if iszero(check(p)) { fail() }
+			return(p, 32)
+			function alloc(size) -> p {
+				p := mload(0x40)
+				let newEnd := add(p, and(add(size, 31), not(31)))
+				if gt(newEnd, 0xffffffffffffffff) { fail() }
+				mstore(0x40, newEnd)
+			}
+			function store(p, v) {
+				mstore(p, v)
+				mstore(p, v)
+				sstore(v, mload(p))
+				sstore(v, mload(p))
+			}
+			function check(p) -> ok {
+				ok := 1
+				for { let i := 0 } lt(i, 10) { i := add(i, 1) } {
+					let v := mload(p)
+					if eq(v, i) { ok := 0 leave }
+				}
+			}
+			function fail() { revert(0, 0) }
+		}
+	)",
+	// The presence of msize changes what LoadResolver and LoopInvariantCodeMotion may do everywhere.
+	R"(
+		{
+			let a := calldataload(0)
+			mstore(a, msize())
+			sstore(0, f(a))
+			function f(x) -> y {
+				let s := sload(x)
+				for { let i := 0 } lt(i, x) { i := add(i, 1) } {
+					let m := mload(s)
+					y := add(y, m)
+					mstore(s, y)
+				}
+				y := add(y, sload(x))
+			}
+		}
+	)",
+	// No functions at all.
+	R"(
+		{
+			let x := calldataload(0)
+			let y := add(x, x)
+			if lt(y, x) { revert(0, 0) }
+			sstore(add(x, x), y)
+		}
+	)"
+};
+
+std::vector<std::string> const objectSources{
+	R"(
+		object "A" {
+			code {
+				datacopy(0, dataoffset("A_deployed"), datasize("A_deployed"))
+				return(0, datasize("A_deployed"))
+			}
+			object "A_deployed" {
+				code {
+					let x := calldataload(0)
+					switch x
+					case 0 {
+						datacopy(0, dataoffset("B"), datasize("B"))
+						sstore(0, create(0, 0, datasize("B")))
+					}
+					default {
+						datacopy(0, dataoffset("C"), datasize("C"))
+						sstore(1, create(0, 0, datasize("C")))
+					}
+				}
+				object "B" {
+					code { sstore(0, add(calldataload(0), 1)) }
+				}
+				object "C" {
+					code {
+						for { let i := 0 } lt(i, calldataload(0)) { i := add(i, 1) } { sstore(i, mload(i)) }
+					}
+				}
+			}
+		}
+	)",
+	// The same helper functions in the creation and the runtime code.
+	R"(
+		object "D" {
+			code {
+				sstore(0, checked_add(sload(0), callvalue()))
+				datacopy(0, dataoffset("D_deployed"), datasize("D_deployed"))
+				return(0, datasize("D_deployed"))
+				function checked_add(a, b) -> r {
+					r := add(a, b)
+					if gt(a, r) { panic(0x11) }
+				}
+				function panic(code) {
+					mstore(0, shl(224, 0x4e487b71))
+					mstore(4, code)
+					revert(0, 0x24)
+				}
+			}
+			object "D_deployed" {
+				code {
+					let s := calldataload(0)
+					sstore(s, checked_add(sload(s), calldataload(32)))
+					sstore(add(s, 1), checked_add(sload(add(s, 1)), 1))
+					function checked_add(a, b) -> r {
+						r := add(a, b)
+						if gt(a, r) { panic(0x11) }
+					}
+					function panic(code) {
+						mstore(0, shl(224, 0x4e487b71))
+						mstore(4, code)
+						revert(0, 0x24)
+					}
+				}
+				data "metadata" hex"a2646970"
+			}
+		}
+	)"
+};
+
+std::string optimize(
+	std::string const& _source,
+	size_t _concurrency,
+	frontend::OptimiserSettings const& _settings = frontend::OptimiserSettings::full()
+)
+{
+	YulStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion(),
+		YulStack::Language::StrictAssembly,
+		_settings,
+		langutil::DebugInfoSelection::All()
+	);
+	stack.setConcurrency(_concurrency);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", _source));
+	stack.optimize();
+	return stack.print();
+}
+
+std::string assemble(std::string const& _source, size_t _concurrency)
+{
+	YulStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion(),
+		YulStack::Language::StrictAssembly,
+		frontend::OptimiserSettings::full(),
+		langutil::DebugInfoSelection::All()
+	);
+	stack.setConcurrency(_concurrency);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", _source));
+	stack.optimize();
+	MachineAssemblyObject result = stack.assemble(YulStack::Machine::EVM);
+	BOOST_REQUIRE(result.bytecode);
+	return result.assembly + "\n" + result.bytecode->toHex();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulParallelOptimisation)
+
+BOOST_AUTO_TEST_CASE(function_local_steps)
+{
+	auto const& steps = OptimiserSuite::allSteps();
+	for (char const* step: {"CommonSubexpressionEliminator", "ExpressionSimplifier", "LoadResolver", "UnusedAssignEliminator"})
+		BOOST_CHECK_MESSAGE(steps.at(step)->isFunctionLocal(), step);
+	// Steps that look at other functions or dispense new names.
+	for (char const* step: {"FullInliner", "UnusedPruner", "EquivalentFunctionCombiner", "SSATransform", "ExpressionSplitter"})
+		BOOST_CHECK_MESSAGE(!steps.at(step)->isFunctionLocal(), step);
+}
+
+BOOST_AUTO_TEST_CASE(result_does_not_depend_on_concurrency)
+{
+	for (std::string const& source: sources)
+	{
+		std::string const sequential = optimize(source, 1);
+		BOOST_CHECK_EQUAL(optimize(source, 2), sequential);
+		BOOST_CHECK_EQUAL(optimize(source, 8), sequential);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(single_steps_do_not_depend_on_concurrency)
+{
+	// Runs every function-local step on its own, after splitting the expressions and
+	// transforming the code into SSA form, so that all steps find something to do.
+	for (auto const& [name, step]: OptimiserSuite::allSteps())
+	{
+		if (!step->isFunctionLocal())
+			continue;
+		frontend::OptimiserSettings settings = frontend::OptimiserSettings::full();
+		settings.yulOptimiserSteps = std::string("xa") + OptimiserSuite::stepNameToAbbreviationMap().at(name);
+		settings.yulOptimiserCleanupSteps = "";
+		for (std::string const& source: sources)
+			BOOST_CHECK_MESSAGE(optimize(source, 4, settings) == optimize(source, 1, settings), name);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(code_of_sub_objects_does_not_depend_on_concurrency)
+{
+	for (std::string const& source: objectSources)
+	{
+		std::string const sequential = assemble(source, 1);
+		BOOST_CHECK_EQUAL(assemble(source, 2), sequential);
+		BOOST_CHECK_EQUAL(assemble(source, 8), sequential);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
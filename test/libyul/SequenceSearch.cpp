@@ -0,0 +1,108 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the search for optimiser step sequences.
+ */
+
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/SequenceSearch.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+std::string const source = R"(
+	{
+		let a := calldataload(0)
+		let b := add(a, 0)
+		sstore(f(b), mul(b, 1))
+		function f(x) -> r {
+			r := add(x, x)
+		}
+	}
+)";
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulSequenceSearch)
+
+BOOST_AUTO_TEST_CASE(deterministic)
+{
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(EVMVersion{});
+	ErrorList errors;
+	auto [object, analysisInfo] = parse(source, dialect, errors);
+	BOOST_REQUIRE(object && errors.empty() && object->code);
+	object->analysisInfo = std::move(analysisInfo);
+	std::string const code = AsmPrinter{}(*object->code);
+
+	GasMeter meter{dialect, false, 200};
+	std::string const initialSequence = "dhfoDgvulfnTUtnIf";
+	Object const& optimizedObject = *object;
+	auto search = [&]() {
+		return OptimiserSequenceSearch::run(
+			dialect,
+			&meter,
+			optimizedObject,
+			true,
+			initialSequence,
+			frontend::OptimiserSettings::DefaultYulOptimiserCleanupSteps,
+			200,
+			20,
+			2
+		);
+	};
+	std::string const sequence = search();
+	BOOST_CHECK_EQUAL(search(), sequence);
+	// The object itself is not optimized.
+	BOOST_CHECK_EQUAL(AsmPrinter{}(*object->code), code);
+}
+
+BOOST_AUTO_TEST_CASE(zero_budget)
+{
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(EVMVersion{});
+	ErrorList errors;
+	auto [object, analysisInfo] = parse(source, dialect, errors);
+	BOOST_REQUIRE(object && errors.empty() && object->code);
+	object->analysisInfo = std::move(analysisInfo);
+
+	GasMeter meter{dialect, true, 1};
+	BOOST_CHECK_EQUAL(
+		OptimiserSequenceSearch::run(dialect, &meter, *object, true, "xarrscLM", "", std::nullopt, 0),
+		"xarrscLM"
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for reusing the stack shuffling operations of stacks with the same pattern.
+ */
+
+#include <libyul/backends/evm/ShufflePlanCache.h>
+#include <libyul/backends/evm/StackHelpers.h>
+
+#include <boost/algorithm/string/replace.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+Stack literals(std::vector<unsigned> const& _values)
+{
+	Stack stack;
+	for (unsigned value: _values)
+		stack.emplace_back(LiteralSlot{value});
+	return stack;
+}
+
+/// @returns the shuffling operations and the stacks before each of them.
+std::string shuffle(Stack _source, Stack const& _target)
+{
+	std::string result;
+	createStackLayout(
+		_source,
+		_target,
+		[&](unsigned _swapDepth) { result += stackToString(_source) + " SWAP" + std::to_string(_swapDepth) + "\n"; },
+		[&](StackSlot const& _slot) { result += stackToString(_source) + " PUSH " + stackSlotToString(_slot) + "\n"; },
+		[&]() { result += stackToString(_source) + " POP\n"; }
+	);
+	return result + stackToString(_source);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulShufflePlanCache, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(key_only_depends_on_pattern)
+{
+	Stack target = literals({3, 1});
+	target.emplace_back(JunkSlot{});
+	BOOST_CHECK(
+		ShufflePlanCache::key(literals({1, 2, 1}), target) ==
+		(ShufflePlanCache::Key{1, 2, 1, 0xffffffff, 3, 1, 0})
+	);
+	BOOST_CHECK(ShufflePlanCache::key(literals({1, 2, 1}), {}) == ShufflePlanCache::key(literals({7, 5, 7}), {}));
+	BOOST_CHECK(ShufflePlanCache::key(literals({1, 2, 1}), {}) != ShufflePlanCache::key(literals({1, 2, 2}), {}));
+}
+
+BOOST_AUTO_TEST_CASE(plans_are_reused_for_the_same_pattern)
+{
+	Stack source = literals({0x10, 0x11, 0x12, 0x10});
+	Stack target = literals({0x12, 0x10, 0x13, 0x11});
+	std::string shuffled = shuffle(source, target);
+	size_t plans = ShufflePlanCache::instance().size();
+
+	BOOST_CHECK_EQUAL(shuffle(source, target), shuffled);
+
+	// Same pattern with different slots.
+	std::string relabeled = shuffle(literals({0x20, 0x21, 0x22, 0x20}), literals({0x22, 0x20, 0x23, 0x21}));
+	BOOST_CHECK_EQUAL(ShufflePlanCache::instance().size(), plans);
+	boost::replace_all(relabeled, "0x2", "0x1");
+	BOOST_CHECK_EQUAL(relabeled, shuffled);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
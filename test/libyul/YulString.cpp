@@ -0,0 +1,164 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/YulString.h>
+
+#include <libsolutil/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+/// @returns the number of resets of the repository since the first call.
+size_t resetCount()
+{
+	static std::atomic<size_t> resets = 0;
+	static YulStringRepository::ResetCallback callback{[]() { ++resets; }};
+	return resets;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulStringTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(empty_string)
+{
+	YulString empty{""};
+	BOOST_CHECK(empty.empty());
+	BOOST_CHECK(empty == YulString{});
+	BOOST_CHECK_EQUAL(empty.str(), "");
+}
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+	YulString a{"round_trip_a"};
+	YulString b{"round_trip_b"};
+	BOOST_CHECK(a != b);
+	BOOST_CHECK(a == YulString{"round_trip_a"});
+	BOOST_CHECK_EQUAL(a.str(), "round_trip_a");
+	BOOST_CHECK_EQUAL(b.str(), "round_trip_b");
+	BOOST_CHECK_EQUAL(a.hash(), YulStringRepository::hash("round_trip_a"));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	size_t const threadCount = 8;
+	size_t const stringCount = 5000;
+	std::vector<std::vector<YulString>> interned(threadCount);
+	util::parallelFor(threadCount, threadCount, [&](size_t _thread) {
+		// All threads intern the same strings, but start at different positions.
+		for (size_t i = 0; i < stringCount; ++i)
+		{
+			size_t index = (i + _thread * stringCount / threadCount) % stringCount;
+			interned[_thread].emplace_back("concurrent_" + std::to_string(index));
+		}
+	});
+
+	for (size_t thread = 0; thread < threadCount; ++thread)
+		for (size_t i = 0; i < stringCount; ++i)
+		{
+			size_t index = (i + thread * stringCount / threadCount) % stringCount;
+			YulString const& name = interned[thread][i];
+			BOOST_REQUIRE_EQUAL(name.str(), "concurrent_" + std::to_string(index));
+			BOOST_REQUIRE(name == interned[0][index]);
+		}
+}
+
+BOOST_AUTO_TEST_CASE(no_reset_while_in_use)
+{
+	YulStringRepository::UsageGuard guard;
+	YulString name{"no_reset_while_in_use"};
+	// The guard has to be held by a different thread than the one attempting the reset.
+	bool wasReset = true;
+	std::thread([&]() { wasReset = YulStringRepository::resetIfUnused(); }).join();
+	BOOST_CHECK(!wasReset);
+	BOOST_CHECK(name == YulString{"no_reset_while_in_use"});
+	BOOST_CHECK_EQUAL(name.str(), "no_reset_while_in_use");
+}
+
+BOOST_AUTO_TEST_CASE(reset_above_threshold)
+{
+	YulString{"reset_above_threshold"};
+	size_t previousThreshold = YulStringRepository::setResetThreshold(1);
+
+	size_t resets = resetCount();
+	{
+		// Without other users, a new guard resets the repository right away.
+		YulStringRepository::UsageGuard guard;
+		BOOST_CHECK_EQUAL(resetCount(), resets + 1);
+	}
+
+	YulString{"reset_above_threshold"};
+	resets = resetCount();
+	std::atomic<bool> acquired = false;
+	std::thread other;
+	{
+		YulStringRepository::UsageGuard guard;
+		BOOST_CHECK_EQUAL(resetCount(), resets + 1);
+		YulString name{"reset_above_threshold"};
+		// The guard of the other thread has to wait until this guard is released.
+		other = std::thread([&]() {
+			YulStringRepository::UsageGuard otherGuard;
+			acquired = true;
+		});
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		BOOST_CHECK(!acquired);
+		BOOST_CHECK_EQUAL(resetCount(), resets + 1);
+		BOOST_CHECK_EQUAL(name.str(), "reset_above_threshold");
+	}
+	other.join();
+	BOOST_CHECK(acquired);
+	BOOST_CHECK_EQUAL(resetCount(), resets + 2);
+
+	YulStringRepository::setResetThreshold(previousThreshold);
+}
+
+BOOST_AUTO_TEST_CASE(nested_guards_above_threshold)
+{
+	size_t previousThreshold = YulStringRepository::setResetThreshold(1);
+
+	{
+		YulStringRepository::UsageGuard guard;
+		YulString name{"nested_guards_above_threshold"};
+		size_t resets = resetCount();
+		{
+			// A nested guard neither waits for the enclosing one nor resets the repository.
+			YulStringRepository::UsageGuard nestedGuard;
+			YulString{"nested_guards_above_threshold_inner"};
+		}
+		BOOST_CHECK_EQUAL(resetCount(), resets);
+		BOOST_CHECK_EQUAL(name.str(), "nested_guards_above_threshold");
+		BOOST_CHECK(name == YulString{"nested_guards_above_threshold"});
+	}
+
+	YulStringRepository::setResetThreshold(previousThreshold);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -120,6 +120,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--evm-version=spuriousDragon",
 			"--via-ir",
 			"--experimental-via-ir",
+			"--jobs=4",
 			"--revert-strings=strip",
 			"--debug-info=location",
 			"--pretty-json",
@@ -132,6 +133,8 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--ast-compact-json", "--asm", "--asm-json", "--opcodes", "--bin", "--bin-runtime", "--abi",
 			"--ir", "--ir-ast-json", "--ir-optimized", "--ir-optimized-ast-json", "--hashes", "--userdoc", "--devdoc", "--metadata", "--storage-layout",
 			"--gas",
+			"--gas-estimation-engine=dataflow",
+			"--time-report",
 			"--combined-json="
 				"abi,metadata,bin,bin-runtime,opcodes,asm,storage-layout,generated-sources,generated-sources-runtime,"
 				"srcmap,srcmap-runtime,function-debug,function-debug-runtime,hashes,devdoc,userdoc,ast",
@@ -141,6 +144,10 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--optimize-yul",
 			"--optimize-runs=1000",
 			"--yul-optimizations=agf",
+			"--optimize-search=10",
+			"--optimize-stack-layout-search=5",
+			"--yul-inline-budget=1000",
+			"--yul-optimizer-profile",
 			"--model-checker-bmc-loop-iterations=2",
 			"--model-checker-contracts=contract1.yul:A,contract2.yul:B",
 			"--model-checker-div-mod-no-slacks",
@@ -179,6 +186,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.output.overwriteFiles = true;
 		expectedOptions.output.evmVersion = EVMVersion::spuriousDragon();
 		expectedOptions.output.viaIR = true;
+		expectedOptions.output.parallelism = 4;
 		expectedOptions.output.revertStrings = RevertStrings::Strip;
 		expectedOptions.output.debugInfoSelection = DebugInfoSelection::fromString("location");
 		expectedOptions.formatting.json = JsonFormat{JsonFormat::Pretty, 7};
@@ -195,6 +203,8 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			true,
 		};
 		expectedOptions.compiler.estimateGas = true;
+		expectedOptions.compiler.gasEstimationEngine = GasEstimationEngine::Dataflow;
+		expectedOptions.compiler.timeReport = true;
 		expectedOptions.compiler.combinedJsonRequests = {
 			true, true, true, true, true,
 			true, true, true, true, true,
@@ -207,6 +217,10 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.optimizer.optimizeYul = true;
 		expectedOptions.optimizer.expectedExecutionsPerDeployment = 1000;
 		expectedOptions.optimizer.yulSteps = "agf";
+		expectedOptions.optimizer.yulSearchBudget = 10;
+		expectedOptions.optimizer.stackLayoutSearchEffort = 5;
+		expectedOptions.optimizer.yulInlineBudget = 1000;
+		expectedOptions.optimizer.yulStepProfile = true;
 
 		expectedOptions.modelChecker.initialize = true;
 		expectedOptions.modelChecker.settings = {
@@ -266,6 +280,17 @@ BOOST_AUTO_TEST_CASE(via_ir_options)
 		BOOST_TEST(parseCommandLine({"solc", viaIrOption, "contract.sol"}).output.viaIR);
 }
 
+BOOST_AUTO_TEST_CASE(jobs_option)
+{
+	BOOST_TEST(parseCommandLine({"solc", "contract.sol"}).output.parallelism == 1);
+	BOOST_TEST(parseCommandLine({"solc", "--jobs=8", "contract.sol"}).output.parallelism == 8);
+	BOOST_TEST(parseCommandLine({"solc", "--strict-assembly", "--jobs=4", "input.yul"}).output.parallelism == 4);
+
+	std::string expectedMessage = "--jobs must be at least 1.";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+	BOOST_CHECK_EXCEPTION(parseCommandLine({"solc", "--jobs=0", "contract.sol"}), CommandLineValidationError, hasCorrectMessage);
+}
+
 BOOST_AUTO_TEST_CASE(assembly_mode_options)
 {
 	static std::vector<std::tuple<std::vector<std::string>, YulStack::Machine, YulStack::Language>> const allowedCombinations = {
@@ -320,6 +345,7 @@ BOOST_AUTO_TEST_CASE(assembly_mode_options)
 				"--optimize",
 				"--optimize-runs=1000",
 				"--yul-optimizations=agf",
+				"--yul-optimizer-profile",
 			};
 
 		CommandLineOptions expectedOptions;
@@ -358,6 +384,7 @@ BOOST_AUTO_TEST_CASE(assembly_mode_options)
 			expectedOptions.optimizer.optimizeEvmasm = true;
 			expectedOptions.optimizer.optimizeYul = true;
 			expectedOptions.optimizer.yulSteps = "agf";
+			expectedOptions.optimizer.yulStepProfile = true;
 			expectedOptions.optimizer.expectedExecutionsPerDeployment = 1000;
 		}
 
@@ -380,6 +407,7 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 		"--ignore-missing",
 		"--output-dir=/tmp/out",           // Accepted but has no effect in Standard JSON mode
 		"--overwrite",                     // Accepted but has no effect in Standard JSON mode
+		"--cache-dir=/tmp/solc-cache",
 		"--evm-version=spuriousDragon",    // Ignored in Standard JSON mode
 		"--revert-strings=strip",          // Accepted but has no effect in Standard JSON mode
 		"--pretty-json",
@@ -403,6 +431,7 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 	expectedOptions.input.ignoreMissingFiles = true;
 	expectedOptions.output.dir = "/tmp/out";
 	expectedOptions.output.overwriteFiles = true;
+	expectedOptions.output.cacheDir = "/tmp/solc-cache";
 	expectedOptions.output.revertStrings = RevertStrings::Strip;
 	expectedOptions.formatting.json = JsonFormat {JsonFormat::Pretty, 1};
 	expectedOptions.formatting.coloredOutput = false;
@@ -423,6 +452,10 @@ BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 		// TODO: This should eventually contain all options.
 		{"--experimental-via-ir", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--via-ir", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--jobs=2", {"--standard-json", "--link"}},
+		{"--time-report", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--yul-optimizer-profile", {"--standard-json", "--link"}},
+		{"--cache-dir=/tmp/solc-cache", {"--assemble", "--yul", "--strict-assembly", "--import-ast", "--link"}},
 		{"--metadata-literal", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--metadata-hash=swarm", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-proved-safe", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},